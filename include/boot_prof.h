@@ -0,0 +1,19 @@
+#ifndef BOOT_PROF_H
+#define BOOT_PROF_H
+
+#include <stdint.h>
+
+// Boot phase timestamps. Any task may mark the end of a phase during startup;
+// the report lists the phases in time order with the gap to the previous one.
+#define BOOT_PROF_MAX_MARKS     16
+
+typedef struct {
+    const char *phase;
+    int64_t time_us;                // esp_timer time, i.e. since the timer started at boot
+} boot_prof_mark_t;
+
+// Function prototypes
+void boot_prof_mark(const char *phase);
+void boot_prof_print_report(void);
+
+#endif // BOOT_PROF_H
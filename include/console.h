@@ -0,0 +1,12 @@
+#ifndef CONSOLE_H
+#define CONSOLE_H
+
+// Serial console command handler, args points past the command name
+typedef void (*console_cmd_handler_t)(const char *args);
+
+// Function prototypes
+void console_init(void);
+void console_register(const char *name, const char *help, console_cmd_handler_t handler);
+void console_task(void *pvParameters);
+
+#endif // CONSOLE_H
@@ -0,0 +1,35 @@
+#ifndef DIRTY_REGION_H
+#define DIRTY_REGION_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Maximum number of disjoint rectangles kept before merging is forced.
+// Build with DIRTY_REGION_MAX_RECTS=1 for a single bounding box.
+#ifndef DIRTY_REGION_MAX_RECTS
+#define DIRTY_REGION_MAX_RECTS  8
+#endif
+
+// Fixed cost of flushing one extra rectangle, in pixels: the address window
+// commands plus transaction setup. Two rectangles are merged when the pixels
+// added by the union cost less than this.
+#define DIRTY_REGION_RECT_COST  32
+
+// Inclusive pixel coordinates
+typedef struct {
+    int16_t x0, y0, x1, y1;
+} dirty_rect_t;
+
+typedef struct {
+    dirty_rect_t rects[DIRTY_REGION_MAX_RECTS];
+    int count;
+    int last;                   // Most recently grown rectangle
+} dirty_region_t;
+
+// Function prototypes
+void dirty_region_clear(dirty_region_t *region);
+void dirty_region_add(dirty_region_t *region, int x0, int y0, int x1, int y1);
+bool dirty_region_empty(const dirty_region_t *region);
+uint32_t dirty_region_area(const dirty_region_t *region);
+
+#endif // DIRTY_REGION_H
@@ -0,0 +1,39 @@
+#ifndef DIRTY_TILES_H
+#define DIRTY_TILES_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+#include "dirty_region.h"
+
+// Dirty tracking on a fixed tile grid: one bit per tile, set in O(1) from the
+// drawing primitives. At flush time each band of tiles is turned into
+// horizontal runs, and identical runs in consecutive bands are stacked into
+// one rectangle.
+#ifndef DIRTY_TILE_W
+#define DIRTY_TILE_W            16
+#endif
+#ifndef DIRTY_TILE_H
+#define DIRTY_TILE_H            8
+#endif
+
+#define DIRTY_TILE_COLS         ((TFT_WIDTH + DIRTY_TILE_W - 1) / DIRTY_TILE_W)
+#define DIRTY_TILE_ROWS         ((TFT_HEIGHT + DIRTY_TILE_H - 1) / DIRTY_TILE_H)
+
+_Static_assert(DIRTY_TILE_COLS <= 32, "one 32-bit mask per tile row");
+
+typedef struct {
+    uint32_t rows[DIRTY_TILE_ROWS];     // Bit n set: tile column n is dirty
+} dirty_tiles_t;
+
+static inline void dirty_tiles_mark_pixel(dirty_tiles_t *tiles, int x, int y) {
+    tiles->rows[y / DIRTY_TILE_H] |= 1u << (x / DIRTY_TILE_W);
+}
+
+// Function prototypes
+void dirty_tiles_clear(dirty_tiles_t *tiles);
+void dirty_tiles_mark_rect(dirty_tiles_t *tiles, int x0, int y0, int x1, int y1);
+bool dirty_tiles_empty(const dirty_tiles_t *tiles);
+int dirty_tiles_to_rects(const dirty_tiles_t *tiles, dirty_rect_t *out, int max);
+
+#endif // DIRTY_TILES_H
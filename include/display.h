@@ -2,28 +2,66 @@
 #define DISPLAY_H
 
 #include <stdint.h>
+#include "font.h"
+#include "image.h"
+#include "panel.h"
 
-// ST7735 Display pins
+// Display pins
 #define TFT_MOSI_PIN        GPIO_NUM_13
 #define TFT_SCLK_PIN        GPIO_NUM_14
 #define TFT_CS_PIN          GPIO_NUM_15
 #define TFT_DC_PIN          GPIO_NUM_2
 #define TFT_RST_PIN         GPIO_NUM_4
 
-// Display dimensions
-#define TFT_WIDTH           128
-#define TFT_HEIGHT          160
-
-// Colors (RGB565)
-#define BLACK               0x0000
-#define BLUE                0x001F
-#define RED                 0xF800
-#define GREEN               0x07E0
-#define CYAN                0x07FF
-#define MAGENTA             0xF81F
-#define YELLOW              0xFFE0
-#define WHITE               0xFFFF
-#define TRANSPARENT         0x0000
+// Display dimensions, from the panel backend and rotation
+#define TFT_WIDTH           PANEL_WIDTH
+#define TFT_HEIGHT          PANEL_HEIGHT
+
+// The framebuffer holds pixels in panel byte order (RGB565, MSB first) so it
+// can be sent over SPI as-is. TFT_COLOR() converts a native RGB565 value and
+// folds to a constant for constant arguments; all drawing functions take
+// colours that have already been converted.
+#define TFT_COLOR(c)        ((uint16_t)((((c) & 0xFF) << 8) | (((c) >> 8) & 0xFF)))
+
+// Colors (RGB565, panel byte order)
+#define BLACK               TFT_COLOR(0x0000)
+#define BLUE                TFT_COLOR(0x001F)
+#define RED                 TFT_COLOR(0xF800)
+#define GREEN               TFT_COLOR(0x07E0)
+#define CYAN                TFT_COLOR(0x07FF)
+#define MAGENTA             TFT_COLOR(0xF81F)
+#define YELLOW              TFT_COLOR(0xFFE0)
+#define WHITE               TFT_COLOR(0xFFFF)
+#define TRANSPARENT         TFT_COLOR(0x0000)
+
+// Called from the flush task when an asynchronous flush has completed
+typedef void (*display_flush_cb_t)(void *arg);
+
+// Flush accounting, bytes as sent over SPI
+typedef struct {
+    uint32_t flushes;
+    uint32_t windows;           // Address windows set
+    uint32_t pixel_bytes;
+    uint32_t command_bytes;     // Window setup commands and parameters
+    uint32_t dropped;           // Draw calls lost to a full display list (band mode)
+} display_flush_stats_t;
+
+// Hardware vertical scrolling is available (rotations 0 and 2). The scroll
+// area always spans the full panel width.
+#define DISPLAY_HW_SCROLL   PANEL_VSCROLL
+
+// Layers. The overlay is a full-width strip of DISPLAY_OVERLAY_ROWS rows with
+// its own buffer and dirty tracking, shown over the background at a chosen
+// row, so a status line can refresh often without touching anything else.
+// 0 builds without it. In band mode layers simply composite in draw order.
+#ifndef DISPLAY_OVERLAY_ROWS
+#define DISPLAY_OVERLAY_ROWS    16
+#endif
+
+typedef enum {
+    DISPLAY_LAYER_BACKGROUND = 0,
+    DISPLAY_LAYER_OVERLAY
+} display_layer_t;
 
 // Function prototypes
 void display_init(void);
@@ -31,6 +69,26 @@ void display_fill_screen(uint16_t color);
 void display_draw_pixel(int16_t x, int16_t y, uint16_t color);
 void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size);
 void display_print_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size);
+void display_draw_text(int16_t x, int16_t y, const char *str, const font_t *font,
+                       uint16_t color, uint16_t bg);
+void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color);
+void display_draw_hline(int16_t x, int16_t y, int16_t w, uint16_t color);
+void display_draw_vline(int16_t x, int16_t y, int16_t h, uint16_t color);
+void display_draw_bitmap1(int16_t x, int16_t y, const uint8_t *bits, int16_t w, int16_t h,
+                          uint16_t color, uint16_t bg);
+void display_draw_bitmap16(int16_t x, int16_t y, const uint16_t *pixels, int16_t w, int16_t h);
+void display_draw_image(int16_t x, int16_t y, const image_t *img);
+void display_scroll_area(int16_t y, int16_t h);
+void display_scroll_to(int16_t start);
+void display_select_layer(display_layer_t layer);
+void display_overlay_show(int16_t y);
+void display_overlay_hide(void);
 void display_welcome(void);
+void display_flush_dirty(void);
+void display_flush_async(display_flush_cb_t cb, void *arg);
+void display_flush_wait(void);
+void display_get_flush_stats(display_flush_stats_t *out);
+void display_reset_flush_stats(void);
 
 #endif // DISPLAY_H
\ No newline at end of file
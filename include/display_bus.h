@@ -0,0 +1,64 @@
+#ifndef DISPLAY_BUS_H
+#define DISPLAY_BUS_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+#include "dirty_region.h"
+#include "display_fb.h"
+
+// Interface between the framebuffer core (display.c) and the code that moves
+// pixels to the panel: display_spi.c on the target, host backends in tools/.
+// Framebuffers are in the display_fb.h format; row buffers are always RGB565.
+
+// Most rectangles a single flush can carry
+#define DISPLAY_BUS_MAX_RECTS           32
+
+// CASET + 4, RASET + 4, RAMWR
+#define DISPLAY_BUS_WINDOW_CMD_BYTES    11
+
+// VSCRDEF + 6, VSCRSADD + 2
+#define DISPLAY_BUS_SCROLL_CMD_BYTES    10
+
+// Hardware vertical scroll, in drawing rows: rows top..top + height - 1
+// wrap around, and row start is shown at the top of that area
+typedef struct {
+    int16_t top;
+    int16_t height;
+    int16_t start;
+} display_scroll_t;
+
+// Overlay strip composited over the framebuffer at flush time: rows y0..y1
+// are read from the strip's own buffer (same format, DISPLAY_FB_STRIDE)
+// instead. rows == NULL: no overlay.
+typedef struct {
+    const display_fb_t *rows;
+    int16_t y0, y1;
+} display_overlay_t;
+
+// Framebuffer row y as the panel should show it
+static inline const display_fb_t *display_bus_row(const display_fb_t *fb,
+                                                  const display_overlay_t *ov, int y) {
+    if (ov->rows && y >= ov->y0 && y <= ov->y1) {
+        return &ov->rows[(y - ov->y0) * DISPLAY_FB_STRIDE];
+    }
+    return &fb[y * DISPLAY_FB_STRIDE];
+}
+
+// True if rows y0..y1 all come from the same buffer, so they are contiguous
+static inline bool display_bus_rows_contiguous(const display_overlay_t *ov, int y0, int y1) {
+    if (!ov->rows || y1 < ov->y0 || y0 > ov->y1) return true;
+    return y0 >= ov->y0 && y1 <= ov->y1;
+}
+
+// Function prototypes
+void display_bus_init(void);
+void display_bus_flush(const display_fb_t *fb, const dirty_rect_t *rects, int count,
+                       display_flush_cb_t cb, void *arg);
+void display_bus_flush_rows(const uint16_t *rows, int y0, int y1,
+                            display_flush_cb_t cb, void *arg);
+void display_bus_wait(void);
+void display_bus_scroll(const display_scroll_t *scroll);
+void display_bus_overlay(const display_overlay_t *overlay);
+
+#endif // DISPLAY_BUS_H
@@ -0,0 +1,96 @@
+#ifndef DISPLAY_FB_H
+#define DISPLAY_FB_H
+
+#include <stdint.h>
+#include <string.h>
+#include "display.h"
+
+// Framebuffer pixel format, shared by the core and the bus backends.
+//
+// 16: RGB565 in panel byte order, sent as-is.
+//  8: one palette index per pixel (half the RAM).
+//  4: two palette indices per byte, low nibble first (a quarter of the RAM).
+//
+// Indexed pixels are expanded to RGB565 through display_palette while the bus
+// fills its DMA buffers. Drawing functions still take RGB565 colours; the
+// palette starts with the colours in display.h and takes new ones until full,
+// after which the nearest entry is used.
+#ifndef DISPLAY_FB_BPP
+#define DISPLAY_FB_BPP          16
+#endif
+
+// Band mode drops the full framebuffer. Draw calls are recorded in a display
+// list and replayed into a DISPLAY_BAND_ROWS high buffer per band at flush
+// time, so RAM use is O(band) instead of O(screen). The list is retained until
+// the next display_fill_screen(), so every frame must start with one.
+#ifndef DISPLAY_BAND_MODE
+#define DISPLAY_BAND_MODE       0
+#endif
+
+#if DISPLAY_FB_BPP == 16
+typedef uint16_t display_fb_t;
+#define DISPLAY_FB_PIXELS_PER_ELEM  1
+#elif DISPLAY_FB_BPP == 8
+typedef uint8_t display_fb_t;
+#define DISPLAY_FB_PIXELS_PER_ELEM  1
+#elif DISPLAY_FB_BPP == 4
+typedef uint8_t display_fb_t;
+#define DISPLAY_FB_PIXELS_PER_ELEM  2
+#else
+#error "DISPLAY_FB_BPP must be 16, 8 or 4"
+#endif
+
+#define DISPLAY_FB_INDEXED      (DISPLAY_FB_BPP != 16)
+#define DISPLAY_FB_STRIDE       (TFT_WIDTH / DISPLAY_FB_PIXELS_PER_ELEM)
+#define DISPLAY_PALETTE_SIZE    (1 << DISPLAY_FB_BPP)
+
+// Static framebuffer size. Internal DRAM has to hold it next to the task
+// stacks and heap, so a 16 bpp frame for the ST7789 (150 KB) or the ST7796S
+// (300 KB) fails at link time or starves the heap. Stop the build instead;
+// host tools have the room and skip the check.
+#ifndef DISPLAY_FB_MAX_BYTES
+#define DISPLAY_FB_MAX_BYTES    (96 * 1024)
+#endif
+#if defined(ESP_PLATFORM) && !DISPLAY_BAND_MODE && \
+    TFT_WIDTH * TFT_HEIGHT * DISPLAY_FB_BPP / 8 > DISPLAY_FB_MAX_BYTES
+#error "Framebuffer too large for internal RAM on this panel: build with DISPLAY_FB_BPP=8 or 4, or DISPLAY_BAND_MODE=1"
+#endif
+
+#if DISPLAY_FB_INDEXED
+// Owned by display.c. Entries are only ever appended, so a flush in progress
+// never sees an index change colour.
+extern uint16_t display_palette[DISPLAY_PALETTE_SIZE];
+#if DISPLAY_FB_BPP == 4
+// Both pixels of a byte in one lookup: first pixel in the low half
+extern uint32_t display_palette_pairs[256];
+#endif
+#endif
+
+// Expands w pixels of framebuffer row y, starting at x, into RGB565
+static inline void display_fb_expand(uint16_t *dst, const display_fb_t *fb, int x, int y, int w) {
+    const display_fb_t *row = &fb[y * DISPLAY_FB_STRIDE];
+#if DISPLAY_FB_BPP == 16
+    memcpy(dst, &row[x], w * sizeof(uint16_t));
+#elif DISPLAY_FB_BPP == 8
+    for (int i = 0; i < w; i++) {
+        dst[i] = display_palette[row[x + i]];
+    }
+#else
+    const uint8_t *src = &row[x >> 1];
+    if (x & 1) {
+        *dst++ = display_palette[*src++ >> 4];
+        w--;
+    }
+    for (; w >= 2; w -= 2) {
+        uint32_t pair = display_palette_pairs[*src++];
+        dst[0] = (uint16_t)pair;
+        dst[1] = (uint16_t)(pair >> 16);
+        dst += 2;
+    }
+    if (w) {
+        *dst = display_palette[*src & 0x0F];
+    }
+#endif
+}
+
+#endif // DISPLAY_FB_H
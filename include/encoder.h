@@ -9,9 +9,30 @@
 #define ENCODER_B_PIN       GPIO_NUM_19  // Out B  
 #define ENCODER_SW_PIN      GPIO_NUM_21  // SW (switch)
 
+// Quadrature state the encoder rests in at a detent (both contacts open,
+// pulled up). The ISR reports one detent each time it gets back there.
+#define ENCODER_REST_STATE  0x3
+
+// Acceleration curve: gain for the time since the previous detent in the
+// same direction, interpolated between points. Detents further apart than
+// the first point count once, closer than the last one count its gain.
+#define ENCODER_ACCEL_CURVE { \
+    { 100, 1 }, \
+    {  50, 2 }, \
+    {  25, 5 }, \
+    {  12, 10 } \
+}
+
+typedef struct {
+    uint16_t interval_ms;
+    uint16_t gain;
+} encoder_accel_point_t;
+
 // Encoder event structure
 typedef struct {
-    int direction;  // 1 for CW, -1 for CCW
+    int delta;          // Signed steps after acceleration, + for CW
+    int detents;        // Signed detents turned, without acceleration
+    uint32_t time_us;   // When the last detent was reached (low bits of esp_timer)
     bool button_pressed;
 } encoder_event_t;
 
@@ -0,0 +1,26 @@
+#ifndef FONT_H
+#define FONT_H
+
+#include <stdint.h>
+
+// Proportional bitmap fonts. The atlases live in src/font_data.c, generated
+// by tools/fontgen/fontgen.py. Glyphs are stored row-major, one uint16_t per
+// row with bit 15 as the leftmost pixel, so each row is blitted as one span.
+typedef struct {
+    uint8_t height;             // Rows per glyph
+    uint8_t line_height;        // Baseline to baseline
+    uint8_t spacing;            // Blank columns after each glyph
+    uint8_t first;              // First character code
+    uint8_t count;              // Glyphs in the atlas
+    const uint8_t *widths;      // Ink width of each glyph
+    const uint16_t *rows;       // count x height rows
+} font_t;
+
+extern const font_t font_small; // 5x7, 8 px lines
+extern const font_t font_large; // 10x14, 16 px lines, for headers
+
+// Function prototypes
+int font_text_width(const font_t *font, const char *str);
+int font_text_advance(const font_t *font, const char *str, int n);
+
+#endif // FONT_H
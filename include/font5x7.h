@@ -0,0 +1,107 @@
+#ifndef FONT5X7_H
+#define FONT5X7_H
+
+// Simple 5x7 font, ASCII 32..126. Each glyph is five column bytes, bit 0 at
+// the top. Expand with an X-macro, G(c0, c1, c2, c3, c4) per glyph, to build
+// whatever layout a renderer needs at compile time.
+#define FONT5X7_FIRST       32
+#define FONT5X7_GLYPHS      95
+
+#define FONT5X7(G) \
+    G(0x00, 0x00, 0x00, 0x00, 0x00) /* ' ' */ \
+    G(0x00, 0x00, 0x5F, 0x00, 0x00) /* '!' */ \
+    G(0x00, 0x07, 0x00, 0x07, 0x00) /* '"' */ \
+    G(0x14, 0x7F, 0x14, 0x7F, 0x14) /* '#' */ \
+    G(0x24, 0x2A, 0x7F, 0x2A, 0x12) /* '$' */ \
+    G(0x23, 0x13, 0x08, 0x64, 0x62) /* '%' */ \
+    G(0x36, 0x49, 0x55, 0x22, 0x50) /* '&' */ \
+    G(0x00, 0x05, 0x03, 0x00, 0x00) /* ''' */ \
+    G(0x00, 0x1C, 0x22, 0x41, 0x00) /* '(' */ \
+    G(0x00, 0x41, 0x22, 0x1C, 0x00) /* ')' */ \
+    G(0x14, 0x08, 0x3E, 0x08, 0x14) /* '*' */ \
+    G(0x08, 0x08, 0x3E, 0x08, 0x08) /* '+' */ \
+    G(0x00, 0x50, 0x30, 0x00, 0x00) /* ',' */ \
+    G(0x08, 0x08, 0x08, 0x08, 0x08) /* '-' */ \
+    G(0x00, 0x60, 0x60, 0x00, 0x00) /* '.' */ \
+    G(0x20, 0x10, 0x08, 0x04, 0x02) /* '/' */ \
+    G(0x3E, 0x51, 0x49, 0x45, 0x3E) /* '0' */ \
+    G(0x00, 0x42, 0x7F, 0x40, 0x00) /* '1' */ \
+    G(0x42, 0x61, 0x51, 0x49, 0x46) /* '2' */ \
+    G(0x21, 0x41, 0x45, 0x4B, 0x31) /* '3' */ \
+    G(0x18, 0x14, 0x12, 0x7F, 0x10) /* '4' */ \
+    G(0x27, 0x45, 0x45, 0x45, 0x39) /* '5' */ \
+    G(0x3C, 0x4A, 0x49, 0x49, 0x30) /* '6' */ \
+    G(0x01, 0x71, 0x09, 0x05, 0x03) /* '7' */ \
+    G(0x36, 0x49, 0x49, 0x49, 0x36) /* '8' */ \
+    G(0x06, 0x49, 0x49, 0x29, 0x1E) /* '9' */ \
+    G(0x00, 0x36, 0x36, 0x00, 0x00) /* ':' */ \
+    G(0x00, 0x56, 0x36, 0x00, 0x00) /* ';' */ \
+    G(0x08, 0x14, 0x22, 0x41, 0x00) /* '<' */ \
+    G(0x14, 0x14, 0x14, 0x14, 0x14) /* '=' */ \
+    G(0x00, 0x41, 0x22, 0x14, 0x08) /* '>' */ \
+    G(0x02, 0x01, 0x51, 0x09, 0x06) /* '?' */ \
+    G(0x32, 0x49, 0x79, 0x41, 0x3E) /* '@' */ \
+    G(0x7E, 0x11, 0x11, 0x11, 0x7E) /* 'A' */ \
+    G(0x7F, 0x49, 0x49, 0x49, 0x36) /* 'B' */ \
+    G(0x3E, 0x41, 0x41, 0x41, 0x22) /* 'C' */ \
+    G(0x7F, 0x41, 0x41, 0x22, 0x1C) /* 'D' */ \
+    G(0x7F, 0x49, 0x49, 0x49, 0x41) /* 'E' */ \
+    G(0x7F, 0x09, 0x09, 0x09, 0x01) /* 'F' */ \
+    G(0x3E, 0x41, 0x49, 0x49, 0x7A) /* 'G' */ \
+    G(0x7F, 0x08, 0x08, 0x08, 0x7F) /* 'H' */ \
+    G(0x00, 0x41, 0x7F, 0x41, 0x00) /* 'I' */ \
+    G(0x20, 0x40, 0x41, 0x3F, 0x01) /* 'J' */ \
+    G(0x7F, 0x08, 0x14, 0x22, 0x41) /* 'K' */ \
+    G(0x7F, 0x40, 0x40, 0x40, 0x40) /* 'L' */ \
+    G(0x7F, 0x02, 0x0C, 0x02, 0x7F) /* 'M' */ \
+    G(0x7F, 0x04, 0x08, 0x10, 0x7F) /* 'N' */ \
+    G(0x3E, 0x41, 0x41, 0x41, 0x3E) /* 'O' */ \
+    G(0x7F, 0x09, 0x09, 0x09, 0x06) /* 'P' */ \
+    G(0x3E, 0x41, 0x51, 0x21, 0x5E) /* 'Q' */ \
+    G(0x7F, 0x09, 0x19, 0x29, 0x46) /* 'R' */ \
+    G(0x46, 0x49, 0x49, 0x49, 0x31) /* 'S' */ \
+    G(0x01, 0x01, 0x7F, 0x01, 0x01) /* 'T' */ \
+    G(0x3F, 0x40, 0x40, 0x40, 0x3F) /* 'U' */ \
+    G(0x1F, 0x20, 0x40, 0x20, 0x1F) /* 'V' */ \
+    G(0x7F, 0x20, 0x18, 0x20, 0x7F) /* 'W' */ \
+    G(0x63, 0x14, 0x08, 0x14, 0x63) /* 'X' */ \
+    G(0x07, 0x08, 0x70, 0x08, 0x07) /* 'Y' */ \
+    G(0x61, 0x51, 0x49, 0x45, 0x43) /* 'Z' */ \
+    G(0x00, 0x7F, 0x41, 0x41, 0x00) /* '[' */ \
+    G(0x02, 0x04, 0x08, 0x10, 0x20) /* '\' */ \
+    G(0x00, 0x41, 0x41, 0x7F, 0x00) /* ']' */ \
+    G(0x04, 0x02, 0x01, 0x02, 0x04) /* '^' */ \
+    G(0x40, 0x40, 0x40, 0x40, 0x40) /* '_' */ \
+    G(0x00, 0x01, 0x02, 0x04, 0x00) /* '`' */ \
+    G(0x20, 0x54, 0x54, 0x54, 0x78) /* 'a' */ \
+    G(0x7F, 0x48, 0x44, 0x44, 0x38) /* 'b' */ \
+    G(0x38, 0x44, 0x44, 0x44, 0x20) /* 'c' */ \
+    G(0x38, 0x44, 0x44, 0x48, 0x7F) /* 'd' */ \
+    G(0x38, 0x54, 0x54, 0x54, 0x18) /* 'e' */ \
+    G(0x08, 0x7E, 0x09, 0x01, 0x02) /* 'f' */ \
+    G(0x0C, 0x52, 0x52, 0x52, 0x3E) /* 'g' */ \
+    G(0x7F, 0x08, 0x04, 0x04, 0x78) /* 'h' */ \
+    G(0x00, 0x44, 0x7D, 0x40, 0x00) /* 'i' */ \
+    G(0x20, 0x40, 0x44, 0x3D, 0x00) /* 'j' */ \
+    G(0x7F, 0x10, 0x28, 0x44, 0x00) /* 'k' */ \
+    G(0x00, 0x41, 0x7F, 0x40, 0x00) /* 'l' */ \
+    G(0x7C, 0x04, 0x18, 0x04, 0x78) /* 'm' */ \
+    G(0x7C, 0x08, 0x04, 0x04, 0x78) /* 'n' */ \
+    G(0x38, 0x44, 0x44, 0x44, 0x38) /* 'o' */ \
+    G(0x7C, 0x14, 0x14, 0x14, 0x08) /* 'p' */ \
+    G(0x08, 0x14, 0x14, 0x18, 0x7C) /* 'q' */ \
+    G(0x7C, 0x08, 0x04, 0x04, 0x08) /* 'r' */ \
+    G(0x48, 0x54, 0x54, 0x54, 0x20) /* 's' */ \
+    G(0x04, 0x3F, 0x44, 0x40, 0x20) /* 't' */ \
+    G(0x3C, 0x40, 0x40, 0x20, 0x7C) /* 'u' */ \
+    G(0x1C, 0x20, 0x40, 0x20, 0x1C) /* 'v' */ \
+    G(0x3C, 0x40, 0x30, 0x40, 0x3C) /* 'w' */ \
+    G(0x44, 0x28, 0x10, 0x28, 0x44) /* 'x' */ \
+    G(0x0C, 0x50, 0x50, 0x50, 0x3C) /* 'y' */ \
+    G(0x44, 0x64, 0x54, 0x4C, 0x44) /* 'z' */ \
+    G(0x00, 0x08, 0x36, 0x41, 0x00) /* '{' */ \
+    G(0x00, 0x00, 0x7F, 0x00, 0x00) /* '|' */ \
+    G(0x00, 0x41, 0x36, 0x08, 0x00) /* '}' */ \
+    G(0x08, 0x08, 0x2A, 0x1C, 0x08) /* '~' */
+
+#endif // FONT5X7_H
@@ -0,0 +1,29 @@
+#ifndef IMAGE_H
+#define IMAGE_H
+
+#include <stdint.h>
+
+// Palette run-length images. The icons live in src/image_data.c, generated
+// by tools/imggen/imggen.py. Pixels are stored row-major as one byte per run:
+// the high nibble is the run length minus one, the low nibble the palette
+// index. Runs may continue on the next row. display_draw_image() decodes the
+// runs straight into the framebuffer, or the band being rendered, without
+// unpacking the image anywhere first.
+#define IMAGE_COLORS_MAX        16
+
+typedef struct {
+    uint16_t w, h;
+    uint8_t colors;             // Palette entries
+    int8_t transparent;         // Palette index that is not drawn, -1 for none
+    uint16_t runs;              // Bytes of run data
+    const uint16_t *palette;    // RGB565, panel byte order
+    const uint8_t *data;
+} image_t;
+
+// 11x9 menu icons
+extern const image_t icon_camera;
+extern const image_t icon_rail;
+extern const image_t icon_settings;
+extern const image_t icon_stack;
+
+#endif // IMAGE_H
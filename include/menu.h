@@ -4,23 +4,7 @@
 #include <stdint.h>
 #include <stdbool.h>
 #include "encoder.h"
-
-// Menu states
-typedef enum {
-    MENU_MAIN = 0,
-    MENU_MOVE,
-    MENU_SETTINGS,
-    MENU_AUTO_STACK
-} menu_state_t;
-
-// Menu configuration structure
-typedef struct {
-    int focus_position;
-    int step_size;
-    bool motor_enabled;
-    menu_state_t current_menu;
-    int menu_selection;
-} menu_config_t;
+#include "menu_view.h"
 
 // Function prototypes
 void menu_init(void);
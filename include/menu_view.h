@@ -0,0 +1,35 @@
+#ifndef MENU_VIEW_H
+#define MENU_VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "plot_view.h"
+#include "stack.h"
+
+// Menu drawing, kept free of FreeRTOS so it also builds for host tools
+
+// Menu states
+typedef enum {
+    MENU_MAIN = 0,
+    MENU_MOVE,
+    MENU_SETTINGS,
+    MENU_AUTO_STACK,
+    MENU_STACK_PROGRESS
+} menu_state_t;
+
+// Menu configuration structure
+typedef struct {
+    int focus_position;
+    int step_size;
+    bool motor_enabled;
+    menu_state_t current_menu;
+    int menu_selection;
+    const plot_ring_t *trace;   // Position/velocity samples for the move screen, or NULL
+    int stack_shots;            // Shots in the next stack
+    const stack_progress_t *stack;  // Running stack for the progress screen, or NULL
+} menu_config_t;
+
+// Function prototypes
+void menu_view_draw(const menu_config_t *cfg);
+
+#endif // MENU_VIEW_H
@@ -0,0 +1,20 @@
+#ifndef MOTION_TRACE_H
+#define MOTION_TRACE_H
+
+#include "plot_view.h"
+
+// Samples the rail position and velocity into a plot ring for the live trace
+// on the move screen. Runs from an esp_timer callback that only reads the
+// stepper's live position counter, so it never waits on or slows down a move.
+#define MOTION_TRACE_HZ             50
+#define MOTION_TRACE_SPEED_WINDOW   4   // Samples the velocity is averaged over
+
+// Trace indices in each sample
+#define MOTION_TRACE_POSITION       0
+#define MOTION_TRACE_VELOCITY       1   // steps/s
+
+// Function prototypes
+void motion_trace_init(void);
+const plot_ring_t *motion_trace_ring(void);
+
+#endif // MOTION_TRACE_H
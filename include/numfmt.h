@@ -0,0 +1,16 @@
+#ifndef NUMFMT_H
+#define NUMFMT_H
+
+#include <stdint.h>
+
+// printf-free number formatting for the display. Both functions write a
+// NUL-terminated string and return its length.
+
+#define NUMFMT_INT_MAX_LEN      12  // "-2147483648" and NUL
+#define NUMFMT_FIXED_MAX_LEN    13  // Plus the decimal point
+
+// Function prototypes
+int numfmt_int(char *buf, int32_t value);
+int numfmt_fixed(char *buf, int32_t value, int decimals);
+
+#endif // NUMFMT_H
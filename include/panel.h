@@ -0,0 +1,123 @@
+#ifndef PANEL_H
+#define PANEL_H
+
+#include <stdint.h>
+
+// Panel controller backends. Everything that differs between controllers
+// lives behind panel_t: the init table, the SPI clock, where the visible area
+// sits in controller RAM and the MADCTL value for each rotation. The
+// framebuffer, dirty tracking and flush pipeline only see the resulting
+// TFT_WIDTH x TFT_HEIGHT and call panel_window() for the address window.
+//
+// Controller, glass size and rotation are build options, since the
+// framebuffer is sized at compile time. The larger panels need
+// DISPLAY_FB_BPP=4/8 or DISPLAY_BAND_MODE=1 to fit into internal RAM;
+// display_fb.h stops the build if the framebuffer would not.
+#define PANEL_ST7735            0
+#define PANEL_ST7789            1
+#define PANEL_ST7796S           2
+
+#ifndef DISPLAY_PANEL
+#define DISPLAY_PANEL           PANEL_ST7735
+#endif
+
+// 0..3, clockwise in 90 degree steps as in the Adafruit drivers
+#ifndef DISPLAY_ROTATION
+#define DISPLAY_ROTATION        0
+#endif
+
+// Controller RAM size in portrait orientation
+#if DISPLAY_PANEL == PANEL_ST7735
+#define PANEL_RAM_WIDTH         128     // As set up by the init table
+#define PANEL_RAM_HEIGHT        160
+#elif DISPLAY_PANEL == PANEL_ST7789
+#define PANEL_RAM_WIDTH         240
+#define PANEL_RAM_HEIGHT        320
+#elif DISPLAY_PANEL == PANEL_ST7796S
+#define PANEL_RAM_WIDTH         320
+#define PANEL_RAM_HEIGHT        480
+#else
+#error "Unknown DISPLAY_PANEL"
+#endif
+
+// Visible glass in portrait orientation, e.g. 240x240 on an ST7789
+#ifndef PANEL_NATIVE_WIDTH
+#define PANEL_NATIVE_WIDTH      PANEL_RAM_WIDTH
+#endif
+#ifndef PANEL_NATIVE_HEIGHT
+#define PANEL_NATIVE_HEIGHT     PANEL_RAM_HEIGHT
+#endif
+
+// Offset of the glass in controller RAM at rotation 0. Centred by default;
+// the opposite margins follow from the RAM size.
+#ifndef PANEL_COL_START
+#define PANEL_COL_START         ((PANEL_RAM_WIDTH - PANEL_NATIVE_WIDTH) / 2)
+#endif
+#ifndef PANEL_ROW_START
+#define PANEL_ROW_START         ((PANEL_RAM_HEIGHT - PANEL_NATIVE_HEIGHT) / 2)
+#endif
+
+// Drawing area after rotation
+#if DISPLAY_ROTATION & 1
+#define PANEL_WIDTH             PANEL_NATIVE_HEIGHT
+#define PANEL_HEIGHT            PANEL_NATIVE_WIDTH
+#else
+#define PANEL_WIDTH             PANEL_NATIVE_WIDTH
+#define PANEL_HEIGHT            PANEL_NATIVE_HEIGHT
+#endif
+
+// Frame memory lines covered by VSCRDEF. Hardware scrolling runs along the
+// controller's rows, which are vertical in rotations 0 and 2 only.
+#if DISPLAY_PANEL == PANEL_ST7735
+#define PANEL_SCROLL_LINES      162
+#else
+#define PANEL_SCROLL_LINES      PANEL_RAM_HEIGHT
+#endif
+#define PANEL_VSCROLL           (!(DISPLAY_ROTATION & 1))
+
+// Commands shared by all ST77xx controllers
+#define ST77XX_NOP              0x00
+#define ST77XX_SWRESET          0x01
+#define ST77XX_SLPIN            0x10
+#define ST77XX_SLPOUT           0x11
+#define ST77XX_NORON            0x13
+#define ST77XX_INVOFF           0x20
+#define ST77XX_INVON            0x21
+#define ST77XX_DISPOFF          0x28
+#define ST77XX_DISPON           0x29
+#define ST77XX_CASET            0x2A
+#define ST77XX_RASET            0x2B
+#define ST77XX_RAMWR            0x2C
+#define ST77XX_VSCRDEF          0x33
+#define ST77XX_MADCTL           0x36
+#define ST77XX_VSCRSADD         0x37
+#define ST77XX_COLMOD           0x3A
+
+#define ST77XX_MADCTL_MY        0x80
+#define ST77XX_MADCTL_MX        0x40
+#define ST77XX_MADCTL_MV        0x20
+#define ST77XX_MADCTL_BGR       0x08
+
+// Init tables use the Adafruit_ST77xx displayInit() list format: number of
+// commands, then for each one the opcode, the argument count (ORed with
+// PANEL_INIT_DELAY if a delay byte follows the arguments), the arguments and
+// the delay in ms (255 means 500 ms).
+#define PANEL_INIT_DELAY        0x80
+
+typedef struct {
+    const char *name;
+    const uint8_t *init_cmds;
+    uint32_t spi_clock_hz;
+    uint8_t madctl[4];          // Per rotation, colour order included
+    uint16_t x_offset;          // Glass origin in controller RAM at DISPLAY_ROTATION
+    uint16_t y_offset;
+} panel_t;
+
+// Function prototypes
+const panel_t *panel_get(void);
+void panel_window(const panel_t *panel, int x0, int y0, int x1, int y1,
+                  uint8_t caset[4], uint8_t raset[4]);
+void panel_scroll(const panel_t *panel, int top, int height, int start,
+                  uint8_t vscrdef[6], uint8_t vscrsadd[2]);
+
+#endif // PANEL_H
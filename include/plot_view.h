@@ -0,0 +1,75 @@
+#ifndef PLOT_VIEW_H
+#define PLOT_VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+#include "display_fb.h"
+
+// Live strip chart. Samples arrive in a fixed-size ring from a producer that
+// never waits for the display. Sample n is drawn in column n % w, so the
+// cursor wraps around: each new sample costs its own column plus clearing
+// the PLOT_GAP columns ahead of it, instead of a full redraw. A full redraw
+// puts every sample in the same column, so both look the same. Kept free of
+// FreeRTOS so it also builds for host tools.
+
+#define PLOT_TRACES             2
+#define PLOT_RING_SIZE          256     // Samples kept (power of two)
+#define PLOT_GAP                2       // Blank columns ahead of the cursor
+
+// Band mode draws the traces into one 1 bpp bitmap each and records those,
+// instead of several display list entries per column. The bitmaps hold a
+// plot of up to PLOT_BAND_MAX_W x PLOT_BAND_MAX_H; a larger one falls back
+// to drawing column by column, which fills the display list quickly.
+#ifndef PLOT_BAND_MAX_W
+#define PLOT_BAND_MAX_W         128
+#endif
+#ifndef PLOT_BAND_MAX_H
+#define PLOT_BAND_MAX_H         48
+#endif
+#define PLOT_BAND_BITS          ((PLOT_BAND_MAX_W + 7) / 8 * PLOT_BAND_MAX_H)
+
+typedef struct {
+    int32_t v[PLOT_TRACES];
+} plot_sample_t;
+
+// Single producer, single consumer. The producer writes the slot and then
+// publishes it by advancing head; the consumer only reads published slots,
+// and at most a view width behind head, so neither side ever blocks.
+typedef struct {
+    plot_sample_t samples[PLOT_RING_SIZE];
+    volatile uint32_t head;     // Samples pushed so far
+} plot_ring_t;
+
+typedef struct {
+    int32_t min, max;           // Value range shown
+    uint16_t color;
+    bool autoscale;             // Recentre the range when a value leaves it
+} plot_trace_t;
+
+typedef struct {
+    int16_t x, y;
+    int16_t w, h;               // w <= PLOT_RING_SIZE / 2
+    uint16_t bg;
+    plot_trace_t traces[PLOT_TRACES];
+    const plot_ring_t *ring;
+    // What the panel shows
+    uint32_t drawn;             // Ring index of the next sample to draw
+    int16_t last_y[PLOT_TRACES];    // Row of the previous sample
+    bool valid;
+#if DISPLAY_BAND_MODE
+    uint8_t bits[PLOT_TRACES][PLOT_BAND_BITS];
+#endif
+} plot_view_t;
+
+#define PLOT_VIEW_INIT(x_, y_, w_, h_, ring_) \
+    { .x = (x_), .y = (y_), .w = (w_), .h = (h_), .bg = BLACK, .ring = (ring_) }
+
+// Function prototypes
+void plot_ring_push(plot_ring_t *ring, const int32_t v[PLOT_TRACES]);
+void plot_view_set_trace(plot_view_t *p, int trace, int32_t min, int32_t max, uint16_t color,
+                         bool autoscale);
+void plot_view_invalidate(plot_view_t *p);
+void plot_view_draw(plot_view_t *p);
+
+#endif // PLOT_VIEW_H
@@ -0,0 +1,16 @@
+#ifndef RENDER_H
+#define RENDER_H
+
+// Display refresh rate limit. Invalidations arriving within one frame
+// period are merged into a single redraw.
+#define RENDER_FPS              30
+#define RENDER_FRAME_PERIOD_MS  (1000 / RENDER_FPS)
+
+// Draws a complete frame into the framebuffer. Runs on the render task only.
+typedef void (*render_draw_fn_t)(void);
+
+// Function prototypes
+void render_start(render_draw_fn_t draw);
+void render_invalidate(void);
+
+#endif // RENDER_H
@@ -0,0 +1,52 @@
+#ifndef SCROLL_VIEW_H
+#define SCROLL_VIEW_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+
+// Text list taller than its window, such as a shot log. Lines live in
+// fixed row slots of the framebuffer and the panel's vertical scroll shows
+// them rotated, so scrolling by a line redraws just the line coming into
+// view and moves the scroll start. Without DISPLAY_HW_SCROLL every scroll
+// redraws the window. Hardware scrolling moves whole panel rows, so the
+// view spans the full width and only one can be attached at a time. Kept
+// free of FreeRTOS so it also builds for host tools.
+
+// Writes the text of line index into buf (len bytes)
+typedef void (*scroll_view_line_fn_t)(int index, char *buf, int len, void *arg);
+
+#define SCROLL_VIEW_LINE_MAX    24  // Longer lines are cut off
+
+typedef struct {
+    int16_t y;
+    int16_t rows;               // Lines visible at once
+    int16_t row_h;              // Pixel rows per line
+    const font_t *font;         // NULL: built-in 5x7 font
+    uint16_t color;
+    uint16_t bg;
+    scroll_view_line_fn_t line;
+    void *arg;
+    int count;                  // Lines available
+    int first;                  // First line to show
+    // What the panel shows
+    int shown_first;
+    int shown_count;
+    int slot0;                  // Row slot holding the first visible line
+    bool valid;
+} scroll_view_t;
+
+#define SCROLL_VIEW_INIT(y_, rows_, row_h_, font_, color_, line_, arg_) \
+    { .y = (y_), .rows = (rows_), .row_h = (row_h_), .font = (font_), .color = (color_), \
+      .bg = BLACK, .line = (line_), .arg = (arg_) }
+
+// Function prototypes
+void scroll_view_attach(scroll_view_t *v);
+void scroll_view_detach(scroll_view_t *v);
+void scroll_view_set_count(scroll_view_t *v, int count);
+void scroll_view_scroll_to(scroll_view_t *v, int first);
+void scroll_view_scroll_to_end(scroll_view_t *v);
+void scroll_view_invalidate(scroll_view_t *v);
+void scroll_view_draw(scroll_view_t *v);
+
+#endif // SCROLL_VIEW_H
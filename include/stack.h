@@ -0,0 +1,43 @@
+#ifndef STACK_H
+#define STACK_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Camera shutter trigger, active high
+#define CAMERA_TRIGGER_PIN      GPIO_NUM_33
+
+// Shot cycle: move one step, settle, trigger, wait for the exposure
+#define STACK_SETTLE_MS         200
+#define STACK_TRIGGER_MS        50
+#define STACK_EXPOSURE_MS       300
+
+#define STACK_CYCLE_WINDOW      8   // Cycles the ETA average is taken over
+#define STACK_LOG_SIZE          64  // Shots kept for the log (power of two)
+
+// One completed shot
+typedef struct {
+    int position;
+    uint32_t cycle_ms;          // Start of the move to the end of the exposure
+} stack_shot_t;
+
+// Snapshot of the running stack. Shot n is in log[n % STACK_LOG_SIZE]; only
+// the last STACK_LOG_SIZE shots are kept.
+typedef struct {
+    int shots_total;
+    int shots_done;
+    int position;
+    int step;
+    uint32_t avg_cycle_ms;      // 0 until a cycle has been measured
+    uint32_t eta_ms;
+    bool running;
+    const stack_shot_t *log;
+} stack_progress_t;
+
+// Function prototypes
+void stack_init(void);
+bool stack_start(int shots, int step);
+void stack_stop(void);
+void stack_get_progress(stack_progress_t *out);
+
+#endif // STACK_H
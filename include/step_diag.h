@@ -0,0 +1,38 @@
+#ifndef STEP_DIAG_H
+#define STEP_DIAG_H
+
+#include <stdint.h>
+#include <stddef.h>
+
+// Number of step edge timestamps kept in the ring (power of two)
+#define STEP_DIAG_RING_SIZE     256
+
+// Jitter histogram: cycle-to-cycle interval change, bucket upper bounds in us.
+// The last bucket collects everything above the final bound.
+#define STEP_DIAG_HIST_BUCKETS  8
+#define STEP_DIAG_HIST_BOUNDS_US { 5, 10, 25, 50, 100, 250, 1000 }
+
+// Timing statistics for one move
+typedef struct {
+    int requested_steps;            // Signed step count passed to the move
+    uint32_t steps;                 // Rising edges recorded
+    int64_t duration_us;            // First to last edge
+    uint32_t interval_min_us;
+    uint32_t interval_avg_us;
+    uint32_t interval_max_us;
+    uint32_t steps_per_sec;         // Achieved step rate
+    uint32_t jitter_max_us;         // Largest cycle-to-cycle change
+    uint32_t jitter_hist[STEP_DIAG_HIST_BUCKETS];
+} step_diag_stats_t;
+
+// Function prototypes
+void step_diag_move_begin(int steps);
+void step_diag_edge(void);
+void step_diag_move_end(void);
+
+void step_diag_get_last_move(step_diag_stats_t *out);
+size_t step_diag_get_edges(uint32_t *dst, size_t max);
+void step_diag_reset(void);
+void step_diag_print_report(void);
+
+#endif // STEP_DIAG_H
@@ -17,6 +17,7 @@ void stepper_init(void);
 void stepper_enable(bool enable);
 void stepper_move(int steps);
 int stepper_get_position(void);
+int stepper_get_live_position(void);
 void stepper_reset_position(void);
 bool stepper_is_enabled(void);
 
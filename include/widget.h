@@ -0,0 +1,79 @@
+#ifndef WIDGET_H
+#define WIDGET_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include "display.h"
+
+// Retained UI. A screen is a tree of widgets; setters only mark a widget
+// dirty when its state really changes, and widget_draw() redraws just the
+// dirty widgets. Each widget remembers the text it last drew and only redraws
+// the characters that differ. Kept free of FreeRTOS so it also builds for
+// host tools.
+
+typedef enum {
+    WIDGET_SCREEN = 0,          // Container, clears its area on a full redraw
+    WIDGET_LABEL,               // Text
+    WIDGET_VALUE,               // Text prefix followed by a fixed-point number
+    WIDGET_MARKER,              // Text shown only while selected
+    WIDGET_IMAGE,               // Run-length image, redrawn whole
+    WIDGET_BAR                  // Progress bar, value in 1/WIDGET_BAR_FULL
+} widget_type_t;
+
+#define WIDGET_TEXT_MAX         24  // Longer text is cut off
+#define WIDGET_BAR_FULL         1000
+
+typedef struct widget {
+    widget_type_t type;
+    int16_t x, y;
+    int16_t w, h;               // Screen area
+    const font_t *font;         // NULL: built-in 5x7 font
+    uint16_t color;
+    uint16_t bg;
+    const char *text;           // Label text, value prefix or marker glyph
+    const image_t *image;
+    int32_t value;
+    uint8_t decimals;           // Value shown as value / 10^decimals
+    bool selected;
+    bool hidden;
+    bool dirty;
+    char shown[WIDGET_TEXT_MAX];    // Text on the panel
+    uint16_t shown_color;
+    int16_t shown_fill;         // Bar columns filled on the panel
+    struct widget *children;
+    uint8_t child_count;
+} widget_t;
+
+// Static initialisers. Everything starts dirty so the first draw is complete.
+#define WIDGET_SCREEN_INIT(kids, bg_) \
+    { .type = WIDGET_SCREEN, .w = TFT_WIDTH, .h = TFT_HEIGHT, .bg = (bg_), .dirty = true, \
+      .children = (kids), .child_count = sizeof(kids) / sizeof((kids)[0]) }
+#define WIDGET_LABEL_INIT(x_, y_, text_, font_, color_) \
+    { .type = WIDGET_LABEL, .x = (x_), .y = (y_), .font = (font_), .color = (color_), \
+      .bg = BLACK, .text = (text_), .dirty = true }
+#define WIDGET_VALUE_INIT(x_, y_, prefix_, color_) \
+    { .type = WIDGET_VALUE, .x = (x_), .y = (y_), .color = (color_), .bg = BLACK, \
+      .text = (prefix_), .dirty = true }
+#define WIDGET_FIXED_INIT(x_, y_, prefix_, decimals_, color_) \
+    { .type = WIDGET_VALUE, .x = (x_), .y = (y_), .color = (color_), .bg = BLACK, \
+      .text = (prefix_), .decimals = (decimals_), .dirty = true }
+#define WIDGET_MARKER_INIT(x_, y_, glyph_, color_) \
+    { .type = WIDGET_MARKER, .x = (x_), .y = (y_), .color = (color_), .bg = BLACK, \
+      .text = (glyph_), .dirty = true }
+#define WIDGET_IMAGE_INIT(x_, y_, image_) \
+    { .type = WIDGET_IMAGE, .x = (x_), .y = (y_), .bg = BLACK, .image = (image_), .dirty = true }
+// Bars fill in color over bg and only the columns that changed are redrawn
+#define WIDGET_BAR_INIT(x_, y_, w_, h_, color_, bg_) \
+    { .type = WIDGET_BAR, .x = (x_), .y = (y_), .w = (w_), .h = (h_), .color = (color_), \
+      .bg = (bg_), .dirty = true }
+
+// Function prototypes
+void widget_invalidate(widget_t *w);
+void widget_set_text(widget_t *w, const char *text);
+void widget_set_color(widget_t *w, uint16_t color);
+void widget_set_value(widget_t *w, int32_t value);
+void widget_set_selected(widget_t *w, bool selected);
+void widget_set_hidden(widget_t *w, bool hidden);
+void widget_draw(widget_t *root);
+
+#endif // WIDGET_H
@@ -0,0 +1,55 @@
+#include <stdbool.h>
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "boot_prof.h"
+
+static const char *TAG = "BOOT_PROF";
+
+static boot_prof_mark_t marks[BOOT_PROF_MAX_MARKS];
+static int mark_count = 0;
+static portMUX_TYPE prof_lock = portMUX_INITIALIZER_UNLOCKED;
+
+// The time is read under the lock, so marks from tasks running in parallel
+// are appended in time order and the table stays sorted
+void boot_prof_mark(const char *phase) {
+    bool full;
+
+    portENTER_CRITICAL(&prof_lock);
+    full = mark_count >= BOOT_PROF_MAX_MARKS;
+    if (!full) {
+        marks[mark_count].phase = phase;
+        marks[mark_count].time_us = esp_timer_get_time();
+        mark_count++;
+    }
+    portEXIT_CRITICAL(&prof_lock);
+
+    if (full) {
+        ESP_LOGW(TAG, "Mark table full, dropping '%s'", phase);
+    }
+}
+
+void boot_prof_print_report(void) {
+    boot_prof_mark_t copy[BOOT_PROF_MAX_MARKS];
+    int count;
+
+    portENTER_CRITICAL(&prof_lock);
+    count = mark_count;
+    for (int i = 0; i < count; i++) {
+        copy[i] = marks[i];
+    }
+    portEXIT_CRITICAL(&prof_lock);
+
+    if (count == 0) {
+        printf("No boot phases recorded\n");
+        return;
+    }
+
+    printf("%-16s %10s %10s\n", "phase", "at ms", "took ms");
+    for (int i = 0; i < count; i++) {
+        int64_t took = copy[i].time_us - (i > 0 ? copy[i - 1].time_us : 0);
+        printf("%-16s %10.1f %10.1f\n", copy[i].phase, copy[i].time_us / 1000.0, took / 1000.0);
+    }
+}
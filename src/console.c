@@ -0,0 +1,107 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "console.h"
+#include "step_diag.h"
+#include "boot_prof.h"
+
+static const char *TAG = "CONSOLE";
+
+#define CONSOLE_MAX_COMMANDS    8
+#define CONSOLE_LINE_LEN        64
+
+typedef struct {
+    const char *name;
+    const char *help;
+    console_cmd_handler_t handler;
+} console_cmd_t;
+
+static console_cmd_t commands[CONSOLE_MAX_COMMANDS];
+static int command_count = 0;
+
+static void cmd_help(const char *args) {
+    for (int i = 0; i < command_count; i++) {
+        printf("%-8s %s\n", commands[i].name, commands[i].help);
+    }
+}
+
+static void cmd_steps(const char *args) {
+    if (strcmp(args, "reset") == 0) {
+        step_diag_reset();
+        printf("Step diagnostics cleared\n");
+    } else if (strcmp(args, "edges") == 0) {
+        uint32_t edges[STEP_DIAG_RING_SIZE];
+        size_t n = step_diag_get_edges(edges, STEP_DIAG_RING_SIZE);
+        for (size_t i = 1; i < n; i++) {
+            printf("%lu\n", (unsigned long)(edges[i] - edges[i - 1]));
+        }
+    } else {
+        step_diag_print_report();
+    }
+}
+
+static void cmd_boot(const char *args) {
+    boot_prof_print_report();
+}
+
+void console_register(const char *name, const char *help, console_cmd_handler_t handler) {
+    if (command_count >= CONSOLE_MAX_COMMANDS) {
+        ESP_LOGW(TAG, "Command table full, dropping '%s'", name);
+        return;
+    }
+    commands[command_count].name = name;
+    commands[command_count].help = help;
+    commands[command_count].handler = handler;
+    command_count++;
+}
+
+void console_init(void) {
+    console_register("help", "List commands", cmd_help);
+    console_register("steps", "Step timing report [reset|edges]", cmd_steps);
+    console_register("boot", "Boot phase timing report", cmd_boot);
+
+    ESP_LOGI(TAG, "Console initialized");
+}
+
+static void console_execute(char *line) {
+    char *args = line;
+    while (*args && *args != ' ') args++;
+    if (*args) *args++ = '\0';
+
+    for (int i = 0; i < command_count; i++) {
+        if (strcmp(line, commands[i].name) == 0) {
+            commands[i].handler(args);
+            return;
+        }
+    }
+    printf("Unknown command '%s', try 'help'\n", line);
+}
+
+// Reads lines from the UART console. Without the UART driver installed stdin
+// is non-blocking, so poll it at a low rate.
+void console_task(void *pvParameters) {
+    char line[CONSOLE_LINE_LEN];
+    int len = 0;
+
+    while (1) {
+        int c = fgetc(stdin);
+        if (c == EOF) {
+            clearerr(stdin);
+            vTaskDelay(pdMS_TO_TICKS(50));
+            continue;
+        }
+
+        if (c == '\r' || c == '\n') {
+            if (len > 0) {
+                line[len] = '\0';
+                console_execute(line);
+                len = 0;
+            }
+        } else if (len < CONSOLE_LINE_LEN - 1) {
+            line[len++] = (char)c;
+        }
+    }
+}
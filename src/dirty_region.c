@@ -0,0 +1,98 @@
+#include <stdint.h>
+
+#include "dirty_region.h"
+
+static inline int32_t rect_area(const dirty_rect_t *r) {
+    return (int32_t)(r->x1 - r->x0 + 1) * (r->y1 - r->y0 + 1);
+}
+
+static inline dirty_rect_t rect_union(const dirty_rect_t *a, const dirty_rect_t *b) {
+    dirty_rect_t u;
+    u.x0 = a->x0 < b->x0 ? a->x0 : b->x0;
+    u.y0 = a->y0 < b->y0 ? a->y0 : b->y0;
+    u.x1 = a->x1 > b->x1 ? a->x1 : b->x1;
+    u.y1 = a->y1 > b->y1 ? a->y1 : b->y1;
+    return u;
+}
+
+static inline bool rect_contains(const dirty_rect_t *outer, const dirty_rect_t *inner) {
+    return inner->x0 >= outer->x0 && inner->x1 <= outer->x1 &&
+           inner->y0 >= outer->y0 && inner->y1 <= outer->y1;
+}
+
+static inline bool rect_overlaps(const dirty_rect_t *a, const dirty_rect_t *b) {
+    return a->x0 <= b->x1 && b->x0 <= a->x1 && a->y0 <= b->y1 && b->y0 <= a->y1;
+}
+
+// Extra pixels sent if a and b go out as one rectangle instead of two
+static inline int32_t merge_cost(const dirty_rect_t *a, const dirty_rect_t *b) {
+    dirty_rect_t u = rect_union(a, b);
+    return rect_area(&u) - rect_area(a) - rect_area(b);
+}
+
+static void remove_rect(dirty_region_t *region, int i) {
+    region->rects[i] = region->rects[--region->count];
+}
+
+void dirty_region_clear(dirty_region_t *region) {
+    region->count = 0;
+    region->last = 0;
+}
+
+void dirty_region_add(dirty_region_t *region, int x0, int y0, int x1, int y1) {
+    dirty_rect_t r = { x0, y0, x1, y1 };
+
+    // Fast path for runs of pixels landing in the rectangle we just grew
+    if (region->last < region->count && rect_contains(&region->rects[region->last], &r)) {
+        return;
+    }
+
+    // Absorb every rectangle that overlaps, or is cheaper to send together
+    // with the new one. A union can reach further rectangles, so rescan
+    // after each merge; this keeps the set disjoint.
+    bool merged;
+    do {
+        merged = false;
+        for (int i = 0; i < region->count; i++) {
+            if (rect_overlaps(&r, &region->rects[i]) ||
+                merge_cost(&r, &region->rects[i]) <= DIRTY_REGION_RECT_COST) {
+                r = rect_union(&r, &region->rects[i]);
+                remove_rect(region, i);
+                merged = true;
+                break;
+            }
+        }
+
+        // Set full: fold in the neighbour that adds the fewest pixels
+        if (!merged && region->count == DIRTY_REGION_MAX_RECTS) {
+            int best = 0;
+            int32_t best_cost = INT32_MAX;
+            for (int i = 0; i < region->count; i++) {
+                int32_t cost = merge_cost(&r, &region->rects[i]);
+                if (cost < best_cost) {
+                    best_cost = cost;
+                    best = i;
+                }
+            }
+            r = rect_union(&r, &region->rects[best]);
+            remove_rect(region, best);
+            merged = true;
+        }
+    } while (merged);
+
+    region->last = region->count;
+    region->rects[region->count++] = r;
+}
+
+bool dirty_region_empty(const dirty_region_t *region) {
+    return region->count == 0;
+}
+
+// Total pixels covered; the rectangles are disjoint
+uint32_t dirty_region_area(const dirty_region_t *region) {
+    uint32_t area = 0;
+    for (int i = 0; i < region->count; i++) {
+        area += rect_area(&region->rects[i]);
+    }
+    return area;
+}
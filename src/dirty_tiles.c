@@ -0,0 +1,82 @@
+#include <string.h>
+
+#include "dirty_tiles.h"
+
+// Bits c0..c1 set; a full 32-bit span would overflow the shift
+static inline uint32_t tile_mask(int c0, int c1) {
+    return (c1 - c0 == 31) ? 0xFFFFFFFFu : (((1u << (c1 - c0 + 1)) - 1) << c0);
+}
+
+void dirty_tiles_clear(dirty_tiles_t *tiles) {
+    memset(tiles, 0, sizeof(*tiles));
+}
+
+void dirty_tiles_mark_rect(dirty_tiles_t *tiles, int x0, int y0, int x1, int y1) {
+    uint32_t mask = tile_mask(x0 / DIRTY_TILE_W, x1 / DIRTY_TILE_W);
+
+    for (int r = y0 / DIRTY_TILE_H; r <= y1 / DIRTY_TILE_H; r++) {
+        tiles->rows[r] |= mask;
+    }
+}
+
+bool dirty_tiles_empty(const dirty_tiles_t *tiles) {
+    for (int r = 0; r < DIRTY_TILE_ROWS; r++) {
+        if (tiles->rows[r]) return false;
+    }
+    return true;
+}
+
+static inline int clamp_max(int v, int max) {
+    return v > max ? max : v;
+}
+
+// Converts the bitmap into pixel rectangles. Runs of dirty tiles within a
+// band become one rectangle each; a run with the same columns as one in the
+// band above extends that rectangle downwards. If more than max rectangles
+// would be needed the overflow is merged into the last one.
+// Returns the number of rectangles written.
+int dirty_tiles_to_rects(const dirty_tiles_t *tiles, dirty_rect_t *out, int max) {
+    int count = 0;
+
+    for (int r = 0; r < DIRTY_TILE_ROWS; r++) {
+        uint32_t bits = tiles->rows[r];
+        int band_start = count;     // Rectangles before this can be extended
+        int y0 = r * DIRTY_TILE_H;
+        int y1 = clamp_max(y0 + DIRTY_TILE_H - 1, TFT_HEIGHT - 1);
+
+        while (bits) {
+            int c0 = __builtin_ctz(bits);
+            int c1 = c0;
+            while (c1 + 1 < DIRTY_TILE_COLS && (bits & (1u << (c1 + 1)))) c1++;
+            bits &= ~tile_mask(c0, c1);
+
+            int x0 = c0 * DIRTY_TILE_W;
+            int x1 = clamp_max((c1 + 1) * DIRTY_TILE_W - 1, TFT_WIDTH - 1);
+
+            // Same columns as a run in the band above: grow it
+            bool extended = false;
+            for (int i = 0; i < band_start; i++) {
+                if (out[i].x0 == x0 && out[i].x1 == x1 && out[i].y1 == y0 - 1) {
+                    out[i].y1 = y1;
+                    extended = true;
+                    break;
+                }
+            }
+            if (extended) continue;
+
+            if (count == max) {
+                dirty_rect_t *last = &out[max - 1];
+                if (x0 < last->x0) last->x0 = x0;
+                if (x1 > last->x1) last->x1 = x1;
+                if (y1 > last->y1) last->y1 = y1;
+                continue;
+            }
+            out[count].x0 = x0;
+            out[count].y0 = y0;
+            out[count].x1 = x1;
+            out[count].y1 = y1;
+            count++;
+        }
+    }
+    return count;
+}
@@ -1,503 +1,634 @@
-#include <stdio.h>
 #include <stdint.h>
-#include "freertos/FreeRTOS.h"
-#include "freertos/task.h"
-#include "driver/gpio.h"
-#include "driver/spi_master.h"
+#include <stdbool.h>
+#include <string.h>
 #include "esp_log.h"
 
 #include "display.h"
+#include "display_bus.h"
+#include "display_fb.h"
+#include "dirty_region.h"
+#include "dirty_tiles.h"
+#include "font.h"
+#include "font5x7.h"
 
-#define TFT_WIDTH 128
-#define TFT_HEIGHT 160
+// Dirty tracking strategy: 0 keeps a small set of merged rectangles
+// (dirty_region), 1 uses the tile bitmap (dirty_tiles), which stays cheap on
+// larger panels where rectangles degrade into one big bounding box.
+#ifndef DISPLAY_DIRTY_TILES
+#define DISPLAY_DIRTY_TILES     0
+#endif
 
-static uint16_t framebuffer[TFT_WIDTH * TFT_HEIGHT];
+#define DISPLAY_BAND_ROWS       16
+#define DISPLAY_BANDS           ((TFT_HEIGHT + DISPLAY_BAND_ROWS - 1) / DISPLAY_BAND_ROWS)
+#define DISPLAY_LIST_MAX_CMDS   128
+#define DISPLAY_LIST_TEXT_SIZE  768
 
-static int dirty_x0 = TFT_WIDTH;
-static int dirty_y0 = TFT_HEIGHT;
-static int dirty_x1 = 0;
-static int dirty_y1 = 0;
+// The raster core is specialised at compile time: with a full framebuffer
+// it is inlined into each entry point once per layer, so on the background
+// the target rows are constants, and the built-in glyphs are drawn by copies
+// of raster_glyph() inlined with their fixed size, so clipping and row
+// addressing fold away and the glyph loops unroll. 1 keeps all of these as
+// runtime values, to measure the difference (tools/display_host).
+#ifndef DISPLAY_GENERIC_RASTER
+#define DISPLAY_GENERIC_RASTER  0
+#endif
 
-static const char *TAG = "DISPLAY";
+#if DISPLAY_GENERIC_RASTER
+#define RASTER_SPECIALISED      __attribute__((noinline))
+#else
+#define RASTER_SPECIALISED      inline __attribute__((always_inline))
+#endif
+
+#if DISPLAY_BAND_MODE && DISPLAY_FB_INDEXED
+#error "Band mode renders RGB565 bands; it needs DISPLAY_FB_BPP 16"
+#endif
+
+static display_flush_stats_t flush_stats;
+
+// Hardware scroll state, sent along with the next flush when it changed
+static display_scroll_t scroll = { 0, TFT_HEIGHT, 0 };
+static bool scroll_changed = false;
+
+#if DISPLAY_BAND_MODE
+// Two band buffers: one is rasterised while the other goes out
+static uint16_t band_buf[2][TFT_WIDTH * DISPLAY_BAND_ROWS] __attribute__((aligned(4)));
+static uint32_t band_sum[DISPLAY_BANDS];    // Checksum of what the panel shows
+static bool band_sum_valid = false;
+#else
+// Layout per display_fb.h. Word aligned so DMA can read it directly.
+static display_fb_t framebuffer[DISPLAY_FB_STRIDE * TFT_HEIGHT] __attribute__((aligned(4)));
+
+#if DISPLAY_DIRTY_TILES
+static dirty_tiles_t dirty;
+#else
+static dirty_region_t dirty;
+#endif
+
+#if DISPLAY_OVERLAY_ROWS
+// Overlay strip, composited over the framebuffer rows it covers by the bus.
+// Its dirty rectangles are in screen coordinates.
+static display_fb_t overlay_fb[DISPLAY_FB_STRIDE * DISPLAY_OVERLAY_ROWS] __attribute__((aligned(4)));
+static dirty_region_t overlay_dirty;
+static int overlay_y = -1;              // Top row, -1 while hidden
+static bool drawing_overlay = false;
+#endif
+#endif
+
+// Raster target: screen rows y0..y1, stored from fb on. The framebuffer or
+// the overlay strip, or in band mode the band being replayed. Every raster
+// function takes the target, so the framebuffer copy sees constants.
+typedef struct {
+    display_fb_t *fb;
+    int y0, y1;
+} raster_target_t;
 
+#if DISPLAY_BAND_MODE
+static raster_target_t band_target;
+#else
+#if DISPLAY_GENERIC_RASTER
+static raster_target_t fb_target = { framebuffer, 0, TFT_HEIGHT - 1 };
+#else
+static const raster_target_t fb_target = { framebuffer, 0, TFT_HEIGHT - 1 };
+#endif
+#if DISPLAY_OVERLAY_ROWS
+static raster_target_t overlay_target = { overlay_fb, 0, -1 };
+#endif
+// Layer drawn into
+static const raster_target_t *layer_target = &fb_target;
 
-// ST7735 Commands  
-#define ST7735_NOP          0x00
-#define ST7735_SWRESET      0x01
-#define ST7735_RDDID        0x04
-#define ST7735_RDDST        0x09
-#define ST7735_SLPIN        0x10
-#define ST7735_SLPOUT       0x11
-#define ST7735_PTLON        0x12
-#define ST7735_NORON        0x13
-#define ST7735_INVOFF       0x20
-#define ST7735_INVON        0x21
-#define ST7735_DISPOFF      0x28
-#define ST7735_DISPON       0x29
-#define ST7735_CASET        0x2A
-#define ST7735_RASET        0x2B
-#define ST7735_RAMWR        0x2C
-#define ST7735_RAMRD        0x2E
-#define ST7735_PTLAR        0x30
-#define ST7735_COLMOD       0x3A
-#define ST7735_MADCTL       0x36
-#define ST7735_FRMCTR1      0xB1
-#define ST7735_FRMCTR2      0xB2
-#define ST7735_FRMCTR3      0xB3
-#define ST7735_INVCTR       0xB4
-#define ST7735_DISSET5      0xB6
-#define ST7735_PWCTR1       0xC0
-#define ST7735_PWCTR2       0xC1
-#define ST7735_PWCTR3       0xC2
-#define ST7735_PWCTR4       0xC3
-#define ST7735_PWCTR5       0xC4
-#define ST7735_VMCTR1       0xC5
-#define ST7735_RDID1        0xDA
-#define ST7735_RDID2        0xDB
-#define ST7735_RDID3        0xDC
-#define ST7735_RDID4        0xDD
-#define ST7735_PWCTR6       0xFC
-#define ST7735_GMCTRP1      0xE0
-#define ST7735_GMCTRN1      0xE1
-
-// Simple 5x7 font
-static const uint8_t font5x7[95][5] = {
-    {0x00,0x00,0x00,0x00,0x00}, // ' '
-    {0x00,0x00,0x5F,0x00,0x00}, // '!'
-    {0x00,0x07,0x00,0x07,0x00}, // '"'
-    {0x14,0x7F,0x14,0x7F,0x14}, // '#'
-    {0x24,0x2A,0x7F,0x2A,0x12}, // '$'
-    {0x23,0x13,0x08,0x64,0x62}, // '%'
-    {0x36,0x49,0x55,0x22,0x50}, // '&'
-    {0x00,0x05,0x03,0x00,0x00}, // '''
-    {0x00,0x1C,0x22,0x41,0x00}, // '('
-    {0x00,0x41,0x22,0x1C,0x00}, // ')'
-    {0x14,0x08,0x3E,0x08,0x14}, // '*'
-    {0x08,0x08,0x3E,0x08,0x08}, // '+'
-    {0x00,0x50,0x30,0x00,0x00}, // ','
-    {0x08,0x08,0x08,0x08,0x08}, // '-'
-    {0x00,0x60,0x60,0x00,0x00}, // '.'
-    {0x20,0x10,0x08,0x04,0x02}, // '/'
-    {0x3E,0x51,0x49,0x45,0x3E}, // '0'
-    {0x00,0x42,0x7F,0x40,0x00}, // '1'
-    {0x42,0x61,0x51,0x49,0x46}, // '2'
-    {0x21,0x41,0x45,0x4B,0x31}, // '3'
-    {0x18,0x14,0x12,0x7F,0x10}, // '4'
-    {0x27,0x45,0x45,0x45,0x39}, // '5'
-    {0x3C,0x4A,0x49,0x49,0x30}, // '6'
-    {0x01,0x71,0x09,0x05,0x03}, // '7'
-    {0x36,0x49,0x49,0x49,0x36}, // '8'
-    {0x06,0x49,0x49,0x29,0x1E}, // '9'
-    {0x00,0x36,0x36,0x00,0x00}, // ':'
-    {0x00,0x56,0x36,0x00,0x00}, // ';'
-    {0x08,0x14,0x22,0x41,0x00}, // '<'
-    {0x14,0x14,0x14,0x14,0x14}, // '='
-    {0x00,0x41,0x22,0x14,0x08}, // '>'
-    {0x02,0x01,0x51,0x09,0x06}, // '?'
-    {0x32,0x49,0x79,0x41,0x3E}, // '@'
-    {0x7E,0x11,0x11,0x11,0x7E}, // 'A'
-    {0x7F,0x49,0x49,0x49,0x36}, // 'B'
-    {0x3E,0x41,0x41,0x41,0x22}, // 'C'
-    {0x7F,0x41,0x41,0x22,0x1C}, // 'D'
-    {0x7F,0x49,0x49,0x49,0x41}, // 'E'
-    {0x7F,0x09,0x09,0x09,0x01}, // 'F'
-    {0x3E,0x41,0x49,0x49,0x7A}, // 'G'
-    {0x7F,0x08,0x08,0x08,0x7F}, // 'H'
-    {0x00,0x41,0x7F,0x41,0x00}, // 'I'
-    {0x20,0x40,0x41,0x3F,0x01}, // 'J'
-    {0x7F,0x08,0x14,0x22,0x41}, // 'K'
-    {0x7F,0x40,0x40,0x40,0x40}, // 'L'
-    {0x7F,0x02,0x0C,0x02,0x7F}, // 'M'
-    {0x7F,0x04,0x08,0x10,0x7F}, // 'N'
-    {0x3E,0x41,0x41,0x41,0x3E}, // 'O'
-    {0x7F,0x09,0x09,0x09,0x06}, // 'P'
-    {0x3E,0x41,0x51,0x21,0x5E}, // 'Q'
-    {0x7F,0x09,0x19,0x29,0x46}, // 'R'
-    {0x46,0x49,0x49,0x49,0x31}, // 'S'
-    {0x01,0x01,0x7F,0x01,0x01}, // 'T'
-    {0x3F,0x40,0x40,0x40,0x3F}, // 'U'
-    {0x1F,0x20,0x40,0x20,0x1F}, // 'V'
-    {0x7F,0x20,0x18,0x20,0x7F}, // 'W'
-    {0x63,0x14,0x08,0x14,0x63}, // 'X'
-    {0x07,0x08,0x70,0x08,0x07}, // 'Y'
-    {0x61,0x51,0x49,0x45,0x43}, // 'Z'
-    {0x00,0x7F,0x41,0x41,0x00}, // '['
-    {0x02,0x04,0x08,0x10,0x20}, // '\'
-    {0x00,0x41,0x41,0x7F,0x00}, // ']'
-    {0x04,0x02,0x01,0x02,0x04}, // '^'
-    {0x40,0x40,0x40,0x40,0x40}, // '_'
-    {0x00,0x01,0x02,0x04,0x00}, // '`'
-    {0x20,0x54,0x54,0x54,0x78}, // 'a'
-    {0x7F,0x48,0x44,0x44,0x38}, // 'b'
-    {0x38,0x44,0x44,0x44,0x20}, // 'c'
-    {0x38,0x44,0x44,0x48,0x7F}, // 'd'
-    {0x38,0x54,0x54,0x54,0x18}, // 'e'
-    {0x08,0x7E,0x09,0x01,0x02}, // 'f'
-    {0x0C,0x52,0x52,0x52,0x3E}, // 'g'
-    {0x7F,0x08,0x04,0x04,0x78}, // 'h'
-    {0x00,0x44,0x7D,0x40,0x00}, // 'i'
-    {0x20,0x40,0x44,0x3D,0x00}, // 'j'
-    {0x7F,0x10,0x28,0x44,0x00}, // 'k'
-    {0x00,0x41,0x7F,0x40,0x00}, // 'l'
-    {0x7C,0x04,0x18,0x04,0x78}, // 'm'
-    {0x7C,0x08,0x04,0x04,0x78}, // 'n'
-    {0x38,0x44,0x44,0x44,0x38}, // 'o'
-    {0x7C,0x14,0x14,0x14,0x08}, // 'p'
-    {0x08,0x14,0x14,0x18,0x7C}, // 'q'
-    {0x7C,0x08,0x04,0x04,0x08}, // 'r'
-    {0x48,0x54,0x54,0x54,0x20}, // 's'
-    {0x04,0x3F,0x44,0x40,0x20}, // 't'
-    {0x3C,0x40,0x40,0x20,0x7C}, // 'u'
-    {0x1C,0x20,0x40,0x20,0x1C}, // 'v'
-    {0x3C,0x40,0x30,0x40,0x3C}, // 'w'
-    {0x44,0x28,0x10,0x28,0x44}, // 'x'
-    {0x0C,0x50,0x50,0x50,0x3C}, // 'y'
-    {0x44,0x64,0x54,0x4C,0x44}, // 'z'
-    {0x00,0x08,0x36,0x41,0x00}, // '{'
-    {0x00,0x00,0x7F,0x00,0x00}, // '|'
-    {0x00,0x41,0x36,0x08,0x00}, // '}'
-    {0x08,0x08,0x2A,0x1C,0x08}  // '~'
+// Calls raster function fn on the selected layer. Specialised, fn is inlined
+// twice: the background copy gets the constant framebuffer target.
+#if DISPLAY_OVERLAY_ROWS && !DISPLAY_GENERIC_RASTER
+#define RASTER(fn, ...) do { \
+        if (drawing_overlay) fn(&overlay_target, __VA_ARGS__); \
+        else fn(&fb_target, __VA_ARGS__); \
+    } while (0)
+#else
+#define RASTER(fn, ...) fn(layer_target, __VA_ARGS__)
+#endif
+#endif
+
+#if DISPLAY_FB_INDEXED
+uint16_t display_palette[DISPLAY_PALETTE_SIZE] = {
+    BLACK, BLUE, RED, GREEN, CYAN, MAGENTA, YELLOW, WHITE
 };
+#if DISPLAY_FB_BPP == 4
+uint32_t display_palette_pairs[256];
+#endif
+static int palette_count = 8;
+
+// Most draws repeat the previous colour
+static uint16_t last_color = BLACK;
+static uint8_t last_index = 0;
+#endif
 
+// Glyphs transposed to rows by the preprocessor, so the blitter reads one
+// byte per glyph row instead of testing a bit in each column. Bit 4 is the
+// leftmost pixel.
+#define GLYPH_BIT(col, row, shift)  ((((col) >> (row)) & 1) << (shift))
+#define GLYPH_ROW(a, b, c, d, e, r) \
+    (GLYPH_BIT(a, r, 4) | GLYPH_BIT(b, r, 3) | GLYPH_BIT(c, r, 2) | GLYPH_BIT(d, r, 1) | GLYPH_BIT(e, r, 0))
+#define GLYPH_ROWS(a, b, c, d, e) { \
+    GLYPH_ROW(a, b, c, d, e, 0), GLYPH_ROW(a, b, c, d, e, 1), GLYPH_ROW(a, b, c, d, e, 2), \
+    GLYPH_ROW(a, b, c, d, e, 3), GLYPH_ROW(a, b, c, d, e, 4), GLYPH_ROW(a, b, c, d, e, 5), \
+    GLYPH_ROW(a, b, c, d, e, 6) },
 
-// Global variables
-static spi_device_handle_t spi;
+static const uint8_t font_rows[FONT5X7_GLYPHS][7] = { FONT5X7(GLYPH_ROWS) };
 
-// Function prototypes
-static void tft_write_command(uint8_t cmd);
-static void tft_write_data(uint8_t data);
-static void tft_write_data_16(uint16_t data);
-static void tft_set_addr_window(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1);
+// Pre-scaled for the size 2 headers: every pixel doubled, bit 9 leftmost
+#define GLYPH_ROW2(a, b, c, d, e, r) \
+    (GLYPH_BIT(a, r, 8) * 3 | GLYPH_BIT(b, r, 6) * 3 | GLYPH_BIT(c, r, 4) * 3 | \
+     GLYPH_BIT(d, r, 2) * 3 | GLYPH_BIT(e, r, 0) * 3)
+#define GLYPH_ROWS2(a, b, c, d, e) { \
+    GLYPH_ROW2(a, b, c, d, e, 0), GLYPH_ROW2(a, b, c, d, e, 1), GLYPH_ROW2(a, b, c, d, e, 2), \
+    GLYPH_ROW2(a, b, c, d, e, 3), GLYPH_ROW2(a, b, c, d, e, 4), GLYPH_ROW2(a, b, c, d, e, 5), \
+    GLYPH_ROW2(a, b, c, d, e, 6) },
 
-static void mark_dirty(int x0, int y0, int x1, int y1) {
-    if (x0 < dirty_x0) dirty_x0 = x0;
-    if (y0 < dirty_y0) dirty_y0 = y0;
-    if (x1 > dirty_x1) dirty_x1 = x1;
-    if (y1 > dirty_y1) dirty_y1 = y1;
+static const uint16_t font_rows2[FONT5X7_GLYPHS][7] = { FONT5X7(GLYPH_ROWS2) };
+
+#if !DISPLAY_BAND_MODE
+static inline void mark_dirty(const raster_target_t *t, int x0, int y0, int x1, int y1) {
+#if DISPLAY_OVERLAY_ROWS
+    if (t != &fb_target) {
+        dirty_region_add(&overlay_dirty, x0, y0, x1, y1);
+        return;
+    }
+#endif
+#if DISPLAY_DIRTY_TILES
+    dirty_tiles_mark_rect(&dirty, x0, y0, x1, y1);
+#else
+    dirty_region_add(&dirty, x0, y0, x1, y1);
+#endif
 }
 
-void framebuffer_set_pixel(int x, int y, uint16_t color) {
-    if (x < 0 || x >= TFT_WIDTH || y < 0 || y >= TFT_HEIGHT) return;
-    int idx = y * TFT_WIDTH + x;
-    if (framebuffer[idx] != color) {
-        framebuffer[idx] = color;
-        mark_dirty(x, y, x, y);
+static inline void mark_dirty_pixel(const raster_target_t *t, int x, int y) {
+#if DISPLAY_OVERLAY_ROWS
+    if (t != &fb_target) {
+        dirty_region_add(&overlay_dirty, x, y, x, y);
+        return;
     }
+#endif
+#if DISPLAY_DIRTY_TILES
+    dirty_tiles_mark_pixel(&dirty, x, y);
+#else
+    dirty_region_add(&dirty, x, y, x, y);
+#endif
 }
 
-void display_fill_screen(uint16_t color) {
-    for (int i = 0; i < TFT_WIDTH * TFT_HEIGHT; i++) {
-        framebuffer[i] = color;
+static inline void dirty_clear(void) {
+#if DISPLAY_DIRTY_TILES
+    dirty_tiles_clear(&dirty);
+#else
+    dirty_region_clear(&dirty);
+#endif
+}
+
+// Collects the dirty area as at most max rectangles for the bus. Any more
+// are merged into the last one, as dirty_tiles_to_rects() does.
+static int dirty_collect(dirty_rect_t *rects, int max) {
+#if DISPLAY_DIRTY_TILES
+    return dirty_tiles_to_rects(&dirty, rects, max);
+#else
+    int count = dirty.count < max ? dirty.count : max;
+    memcpy(rects, dirty.rects, count * sizeof(dirty_rect_t));
+    for (int i = count; i < dirty.count; i++) {
+        dirty_rect_t *last = &rects[count - 1];
+        const dirty_rect_t *r = &dirty.rects[i];
+        if (r->x0 < last->x0) last->x0 = r->x0;
+        if (r->y0 < last->y0) last->y0 = r->y0;
+        if (r->x1 > last->x1) last->x1 = r->x1;
+        if (r->y1 > last->y1) last->y1 = r->y1;
     }
-    mark_dirty(0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
+    return count;
+#endif
 }
+#endif
 
-void display_flush_dirty(void) {
-    if (dirty_x0 > dirty_x1 || dirty_y0 > dirty_y1) {
-        // No dirty region
-        return;
+#if DISPLAY_FB_INDEXED
+#if DISPLAY_FB_BPP == 4
+static void palette_update_pairs(int index) {
+    for (int i = 0; i < 16; i++) {
+        display_palette_pairs[index | (i << 4)] = display_palette[index] | ((uint32_t)display_palette[i] << 16);
+        display_palette_pairs[i | (index << 4)] = display_palette[i] | ((uint32_t)display_palette[index] << 16);
     }
-    
-    int w = dirty_x1 - dirty_x0 + 1;
-    int h = dirty_y1 - dirty_y0 + 1;
-    
-    tft_set_addr_window(dirty_x0, dirty_y0, dirty_x1, dirty_y1);
-    
-    for (int y = dirty_y0; y <= dirty_y1; y++) {
-        spi_transaction_t t = {};
-        t.length = w * 16;  // bits (16 bits per pixel)
-        t.tx_buffer = &framebuffer[y * TFT_WIDTH + dirty_x0];
-        gpio_set_level(TFT_DC_PIN, 1);  // Data mode
-        spi_device_polling_transmit(spi, &t);
+}
+#endif
+
+// Squared RGB565 distance, colours in panel byte order
+static uint32_t color_distance(uint16_t a, uint16_t b) {
+    a = TFT_COLOR(a);
+    b = TFT_COLOR(b);
+    int dr = (a >> 11) - (b >> 11);
+    int dg = ((a >> 5) & 0x3F) - ((b >> 5) & 0x3F);
+    int db = (a & 0x1F) - (b & 0x1F);
+    return dr * dr * 4 + dg * dg + db * db * 4;
+}
+
+static uint8_t color_index(uint16_t color) {
+    if (color == last_color) return last_index;
+
+    int index = -1;
+    for (int i = 0; i < palette_count; i++) {
+        if (display_palette[i] == color) {
+            index = i;
+            break;
+        }
     }
-    
-    // Reset dirty rectangle
-    dirty_x0 = TFT_WIDTH;
-    dirty_y0 = TFT_HEIGHT;
-    dirty_x1 = 0;
-    dirty_y1 = 0;
+    if (index < 0 && palette_count < DISPLAY_PALETTE_SIZE) {
+        index = palette_count++;
+        display_palette[index] = color;
+#if DISPLAY_FB_BPP == 4
+        palette_update_pairs(index);
+#endif
+    }
+    if (index < 0) {
+        // Palette full: nearest match
+        uint32_t best = UINT32_MAX;
+        for (int i = 0; i < palette_count; i++) {
+            uint32_t d = color_distance(color, display_palette[i]);
+            if (d < best) {
+                best = d;
+                index = i;
+            }
+        }
+    }
+
+    last_color = color;
+    last_index = index;
+    return index;
 }
+#endif
 
+// Framebuffer value of one pixel: the colour, or its palette index
+static inline display_fb_t pixel_value(uint16_t color) {
+#if DISPLAY_FB_INDEXED
+    return color_index(color);
+#else
+    return color;
+#endif
+}
 
-void display_init(void) {
-    esp_err_t ret;
-    
-    // Initialize SPI bus
-    spi_bus_config_t buscfg = {
-        .miso_io_num = -1,
-        .mosi_io_num = TFT_MOSI_PIN,
-        .sclk_io_num = TFT_SCLK_PIN,
-        .quadwp_io_num = -1,
-        .quadhd_io_num = -1,
-        .max_transfer_sz = TFT_WIDTH * TFT_HEIGHT * 2
-    };
-    
-    ret = spi_bus_initialize(HSPI_HOST, &buscfg, SPI_DMA_CH_AUTO);
-    ESP_ERROR_CHECK(ret);
-    
-    // Initialize SPI device
-    spi_device_interface_config_t devcfg = {
-        .clock_speed_hz = 10 * 1000 * 1000,  // 10 MHz
-        .mode = 0,
-        .spics_io_num = TFT_CS_PIN,
-        .queue_size = 7,
-    };
-    
-    ret = spi_bus_add_device(HSPI_HOST, &devcfg, &spi);
-    ESP_ERROR_CHECK(ret);
-    
-    // Configure control pins
-    gpio_config_t io_conf = {};
-    io_conf.intr_type = GPIO_INTR_DISABLE;
-    io_conf.mode = GPIO_MODE_OUTPUT;
-    io_conf.pin_bit_mask = (1ULL << TFT_DC_PIN) | (1ULL << TFT_RST_PIN);
-    io_conf.pull_down_en = 0;
-    io_conf.pull_up_en = 0;
-    gpio_config(&io_conf);
-    
-    // Reset display
-    gpio_set_level(TFT_RST_PIN, 0);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    gpio_set_level(TFT_RST_PIN, 1);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
-    // Initialize ST7735 display
-    tft_write_command(ST7735_SWRESET);
-    vTaskDelay(pdMS_TO_TICKS(150));
-    
-    tft_write_command(ST7735_SLPOUT);
-    vTaskDelay(pdMS_TO_TICKS(500));
-    
-    tft_write_command(ST7735_FRMCTR1);
-    tft_write_data(0x01);
-    tft_write_data(0x2C);
-    tft_write_data(0x2D);
-    
-    tft_write_command(ST7735_FRMCTR2);
-    tft_write_data(0x01);
-    tft_write_data(0x2C);
-    tft_write_data(0x2D);
-    
-    tft_write_command(ST7735_FRMCTR3);
-    tft_write_data(0x01);
-    tft_write_data(0x2C);
-    tft_write_data(0x2D);
-    tft_write_data(0x01);
-    tft_write_data(0x2C);
-    tft_write_data(0x2D);
-    
-    tft_write_command(ST7735_INVCTR);
-    tft_write_data(0x07);
-    
-    tft_write_command(ST7735_PWCTR1);
-    tft_write_data(0xA2);
-    tft_write_data(0x02);
-    tft_write_data(0x84);
-    
-    tft_write_command(ST7735_PWCTR2);
-    tft_write_data(0xC5);
-    
-    tft_write_command(ST7735_PWCTR3);
-    tft_write_data(0x0A);
-    tft_write_data(0x00);
-    
-    tft_write_command(ST7735_PWCTR4);
-    tft_write_data(0x8A);
-    tft_write_data(0x2A);
-    
-    tft_write_command(ST7735_PWCTR5);
-    tft_write_data(0x8A);
-    tft_write_data(0xEE);
-    
-    tft_write_command(ST7735_VMCTR1);
-    tft_write_data(0x0E);
-    
-    tft_write_command(ST7735_INVOFF);
-    
-    tft_write_command(ST7735_MADCTL);
-    tft_write_data(0xC8);
-    
-    tft_write_command(ST7735_COLMOD);
-    tft_write_data(0x05);
-    
-    tft_write_command(ST7735_CASET);
-    tft_write_data(0x00);
-    tft_write_data(0x00);
-    tft_write_data(0x00);
-    tft_write_data(0x7F);
-    
-    tft_write_command(ST7735_RASET);
-    tft_write_data(0x00);
-    tft_write_data(0x00);
-    tft_write_data(0x00);
-    tft_write_data(0x9F);
-    
-    tft_write_command(ST7735_GMCTRP1);
-    tft_write_data(0x02);
-    tft_write_data(0x1c);
-    tft_write_data(0x07);
-    tft_write_data(0x12);
-    tft_write_data(0x37);
-    tft_write_data(0x32);
-    tft_write_data(0x29);
-    tft_write_data(0x2d);
-    tft_write_data(0x29);
-    tft_write_data(0x25);
-    tft_write_data(0x2B);
-    tft_write_data(0x39);
-    tft_write_data(0x00);
-    tft_write_data(0x01);
-    tft_write_data(0x03);
-    tft_write_data(0x10);
-    
-    tft_write_command(ST7735_GMCTRN1);
-    tft_write_data(0x03);
-    tft_write_data(0x1d);
-    tft_write_data(0x07);
-    tft_write_data(0x06);
-    tft_write_data(0x2E);
-    tft_write_data(0x2C);
-    tft_write_data(0x29);
-    tft_write_data(0x2D);
-    tft_write_data(0x2E);
-    tft_write_data(0x2E);
-    tft_write_data(0x37);
-    tft_write_data(0x3F);
-    tft_write_data(0x00);
-    tft_write_data(0x00);
-    tft_write_data(0x02);
-    tft_write_data(0x10);
-    
-    tft_write_command(ST7735_NORON);
-    vTaskDelay(pdMS_TO_TICKS(10));
-    
-    tft_write_command(ST7735_DISPON);
-    vTaskDelay(pdMS_TO_TICKS(100));
-    
-    // Clear screen
-    display_fill_screen(BLACK);
-    
-    ESP_LOGI(TAG, "Display initialized");
+// Framebuffer element that fills a run of pixels with color
+static inline display_fb_t fill_value(uint16_t color) {
+#if DISPLAY_FB_BPP == 4
+    return color_index(color) * 0x11;
+#else
+    return pixel_value(color);
+#endif
 }
 
-static void tft_write_command(uint8_t cmd) {
-    gpio_set_level(TFT_DC_PIN, 0);  // Command mode
+// Stores pixel value v at x of a target row. Returns true if it changed.
+static inline bool row_put(display_fb_t *row, int x, display_fb_t v) {
+#if DISPLAY_FB_BPP == 4
+    display_fb_t *p = &row[x >> 1];
+    int shift = (x & 1) * 4;
+    display_fb_t n = (*p & ~(0x0F << shift)) | (v << shift);
+#else
+    display_fb_t *p = &row[x];
+    display_fb_t n = v;
+#endif
+    if (*p == n) return false;
+    *p = n;
+    return true;
+}
 
-    spi_transaction_t t = {
-        .flags = SPI_TRANS_USE_TXDATA,
-        .length = 8,
-    };
-    t.tx_data[0] = cmd;
+static inline display_fb_t *target_row(const raster_target_t *t, int y) {
+    return &t->fb[(y - t->y0) * DISPLAY_FB_STRIDE];
+}
 
-    ESP_ERROR_CHECK(spi_device_polling_transmit(spi, &t));
+static inline void put_pixel(const raster_target_t *t, int x, int y, uint16_t color) {
+    if (x < 0 || x >= TFT_WIDTH || y < t->y0 || y > t->y1) return;
+#if DISPLAY_BAND_MODE
+    row_put(target_row(t, y), x, pixel_value(color));
+#else
+    if (row_put(target_row(t, y), x, pixel_value(color))) {
+        mark_dirty_pixel(t, x, y);
+    }
+#endif
 }
 
-static void tft_write_data(uint8_t data) {
-    gpio_set_level(TFT_DC_PIN, 1);  // Data mode
+// Clips x0..x1, y0..y1 (inclusive) against the panel and the target rows
+static inline bool clip_rect(const raster_target_t *t, int *x0, int *y0, int *x1, int *y1) {
+    if (*x0 < 0) *x0 = 0;
+    if (*x1 > TFT_WIDTH - 1) *x1 = TFT_WIDTH - 1;
+    if (*y0 < t->y0) *y0 = t->y0;
+    if (*y1 > t->y1) *y1 = t->y1;
+    return *x0 <= *x1 && *y0 <= *y1;
+}
 
-    spi_transaction_t t = {
-        .flags = SPI_TRANS_USE_TXDATA,
-        .length = 8,
-    };
-    t.tx_data[0] = data;
+#if DISPLAY_FB_BPP == 16
+typedef uint32_t __attribute__((may_alias)) fb_word_t;
 
-    ESP_ERROR_CHECK(spi_device_polling_transmit(spi, &t));
+// Fills n pixels, two per 32-bit store once p is word aligned
+static inline void fill16(uint16_t *p, uint16_t v, int n) {
+    if (n > 0 && ((uintptr_t)p & 2)) {
+        *p++ = v;
+        n--;
+    }
+    fb_word_t *w = (fb_word_t *)p;
+    fb_word_t vv = v | ((uint32_t)v << 16);
+    for (; n >= 2; n -= 2) {
+        *w++ = vv;
+    }
+    if (n) {
+        *(uint16_t *)w = v;
+    }
 }
+#endif
 
-static void tft_write_data_16(uint16_t data) {
-    gpio_set_level(TFT_DC_PIN, 1);  // Data mode
-    
-    uint8_t buffer[2] = {data >> 8, data & 0xFF};
-    
-    spi_transaction_t t = {};
-    t.length = 16;
-    t.tx_buffer = buffer;
-    
-    spi_device_polling_transmit(spi, &t);
+// Sets pixels x0..x1 of a target row to fill value v. Only the part that
+// actually changes is written; its extent goes to *c0/*c1. Returns false if
+// nothing changed.
+static inline bool fill_span(display_fb_t *row, int x0, int x1, display_fb_t v, int *c0, int *c1) {
+    int lo = TFT_WIDTH, hi = -1;
+    int l = x0, r = x1;
+
+#if DISPLAY_FB_BPP == 4
+    // Edge pixels that share a byte with a pixel outside the span
+    if (l & 1) {
+        if (row_put(row, l, v & 0x0F)) lo = hi = l;
+        l++;
+    }
+    if (!(r & 1) && r >= l) {
+        if (row_put(row, r, v & 0x0F)) {
+            if (r < lo) lo = r;
+            hi = r;
+        }
+        r--;
+    }
+#endif
+    int i0 = l / DISPLAY_FB_PIXELS_PER_ELEM;
+    int i1 = (r + 1) / DISPLAY_FB_PIXELS_PER_ELEM - 1;
+#if !DISPLAY_BAND_MODE
+    while (i0 <= i1 && row[i0] == v) i0++;
+    while (i1 >= i0 && row[i1] == v) i1--;
+#endif
+    if (i0 <= i1) {
+#if DISPLAY_FB_BPP == 16
+        fill16(&row[i0], v, i1 - i0 + 1);
+#else
+        memset(&row[i0], v, i1 - i0 + 1);
+#endif
+        if (i0 * DISPLAY_FB_PIXELS_PER_ELEM < lo) lo = i0 * DISPLAY_FB_PIXELS_PER_ELEM;
+        if ((i1 + 1) * DISPLAY_FB_PIXELS_PER_ELEM - 1 > hi) hi = (i1 + 1) * DISPLAY_FB_PIXELS_PER_ELEM - 1;
+    }
+
+    *c0 = lo;
+    *c1 = hi;
+    return hi >= 0;
 }
 
-static void tft_set_addr_window(uint8_t x0, uint8_t y0, uint8_t x1, uint8_t y1) {
-    tft_write_command(ST7735_CASET);
-    tft_write_data(0x00);
-    tft_write_data(x0);
-    tft_write_data(0x00);
-    tft_write_data(x1);
-    
-    tft_write_command(ST7735_RASET);
-    tft_write_data(0x00);
-    tft_write_data(y0);
-    tft_write_data(0x00);
-    tft_write_data(y1);
-    
-    tft_write_command(ST7735_RAMWR);
+static RASTER_SPECIALISED void raster_fill_rect(const raster_target_t *t, int x0, int y0, int x1, int y1,
+                                                uint16_t color) {
+    if (!clip_rect(t, &x0, &y0, &x1, &y1)) return;
+
+    display_fb_t v = fill_value(color);
+#if DISPLAY_BAND_MODE
+    int c0, c1;
+    for (int y = y0; y <= y1; y++) {
+        fill_span(target_row(t, y), x0, x1, v, &c0, &c1);
+    }
+#else
+    // Consecutive changed rows are marked as one rectangle
+    int run_y0 = -1, run_x0 = 0, run_x1 = 0;
+    for (int y = y0; y <= y1; y++) {
+        int c0, c1;
+        if (fill_span(target_row(t, y), x0, x1, v, &c0, &c1)) {
+            if (run_y0 < 0) {
+                run_y0 = y;
+                run_x0 = c0;
+                run_x1 = c1;
+            } else {
+                if (c0 < run_x0) run_x0 = c0;
+                if (c1 > run_x1) run_x1 = c1;
+            }
+        } else if (run_y0 >= 0) {
+            mark_dirty(t, run_x0, run_y0, run_x1, y - 1);
+            run_y0 = -1;
+        }
+    }
+    if (run_y0 >= 0) mark_dirty(t, run_x0, run_y0, run_x1, y1);
+#endif
 }
 
-#define FILL_CHUNK_SIZE 128  // Number of pixels per chunk (adjust as needed)
+// Clearing a screen of text dirties the text rows, not the whole panel
+static RASTER_SPECIALISED void raster_fill(const raster_target_t *t, uint16_t color) {
+    raster_fill_rect(t, 0, t->y0, TFT_WIDTH - 1, t->y1, color);
+}
 
+// 1 bpp bitmap, rows MSB first and padded to whole bytes. Clear bits are
+// drawn in bg unless bg == color, which leaves them transparent.
+static RASTER_SPECIALISED void raster_bitmap1(const raster_target_t *t, int x, int y, const uint8_t *bits,
+                                              int w, int h, uint16_t color, uint16_t bg) {
+    int x0 = x, y0 = y, x1 = x + w - 1, y1 = y + h - 1;
+    if (!clip_rect(t, &x0, &y0, &x1, &y1)) return;
 
+    int stride = (w + 7) / 8;
+    display_fb_t fg = pixel_value(color);
+    display_fb_t bk = pixel_value(bg);
+    bool opaque = bg != color;
 
-/* void display_fill_screen(uint16_t color) {
-    tft_set_addr_window(0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
-    gpio_set_level(TFT_DC_PIN, 1);  // Data mode
+    for (int py = y0; py <= y1; py++) {
+        const uint8_t *src = &bits[(py - y) * stride];
+        display_fb_t *row = target_row(t, py);
+        int c0 = -1, c1 = -1;
+        for (int px = x0; px <= x1; px++) {
+            int bit = px - x;
+            bool set = src[bit >> 3] & (0x80 >> (bit & 7));
+            if (!set && !opaque) continue;
+            if (row_put(row, px, set ? fg : bk)) {
+                if (c0 < 0) c0 = px;
+                c1 = px;
+            }
+        }
+#if !DISPLAY_BAND_MODE
+        if (c0 >= 0) mark_dirty(t, c0, py, c1, py);
+#else
+        (void)c1;
+#endif
+    }
+}
 
-    uint16_t buffer[FILL_CHUNK_SIZE];
-    for (int i = 0; i < FILL_CHUNK_SIZE; i++) {
-        buffer[i] = __builtin_bswap16(color);  // Convert to big endian (MSB first)
+// RGB565 bitmap in panel byte order, w x h pixels row by row
+static RASTER_SPECIALISED void raster_bitmap16(const raster_target_t *t, int x, int y,
+                                               const uint16_t *pixels, int w, int h) {
+    int x0 = x, y0 = y, x1 = x + w - 1, y1 = y + h - 1;
+    if (!clip_rect(t, &x0, &y0, &x1, &y1)) return;
+
+    for (int py = y0; py <= y1; py++) {
+        const uint16_t *src = &pixels[(py - y) * w];
+        display_fb_t *row = target_row(t, py);
+#if DISPLAY_FB_BPP == 16
+        int l = x0, r = x1;
+#if !DISPLAY_BAND_MODE
+        while (l <= r && row[l] == src[l - x]) l++;
+        while (r >= l && row[r] == src[r - x]) r--;
+        if (l > r) continue;
+        mark_dirty(t, l, py, r, py);
+#endif
+        memcpy(&row[l], &src[l - x], (r - l + 1) * sizeof(uint16_t));
+#else
+        int c0 = -1, c1 = -1;
+        for (int px = x0; px <= x1; px++) {
+            if (row_put(row, px, pixel_value(src[px - x]))) {
+                if (c0 < 0) c0 = px;
+                c1 = px;
+            }
+        }
+#if !DISPLAY_BAND_MODE
+        if (c0 >= 0) mark_dirty(t, c0, py, c1, py);
+#else
+        (void)c1;
+#endif
+#endif
     }
+}
 
-    int total_pixels = TFT_WIDTH * TFT_HEIGHT;
-    while (total_pixels > 0) {
-        int chunk_size = (total_pixels > FILL_CHUNK_SIZE) ? FILL_CHUNK_SIZE : total_pixels;
+// Palette run-length image, see image.h. Each run is split at row ends and
+// written as spans straight into the target rows. Rows above the target are
+// skipped run by run and decoding stops after the last target row, so a band
+// only walks the runs down to its own bottom row.
+static RASTER_SPECIALISED void raster_image(const raster_target_t *t, int x, int y, const image_t *img) {
+    int x0 = x, y0 = y, x1 = x + img->w - 1, y1 = y + img->h - 1;
+    if (!clip_rect(t, &x0, &y0, &x1, &y1)) return;
 
-        spi_transaction_t t = {
-            .length = chunk_size * 16,  // in bits
-            .tx_buffer = buffer,
-        };
-        ESP_ERROR_CHECK(spi_device_polling_transmit(spi, &t));
+    display_fb_t values[IMAGE_COLORS_MAX];
+    for (int i = 0; i < img->colors; i++) {
+        if (i != img->transparent) values[i] = fill_value(img->palette[i]);
+    }
 
-        total_pixels -= chunk_size;
+    int px = 0, py = y;             // Next pixel, px relative to x
+    int c0 = TFT_WIDTH, c1 = -1;    // Changed columns of row py
+    for (int i = 0; i < img->runs && py <= y1; i++) {
+        int index = img->data[i] & 0x0F;
+        int n = (img->data[i] >> 4) + 1;
+        while (n > 0 && py <= y1) {
+            int len = img->w - px < n ? img->w - px : n;
+            int l = x + px, r = l + len - 1;
+            if (l < x0) l = x0;
+            if (r > x1) r = x1;
+            int s0, s1;
+            if (py >= y0 && l <= r && index != img->transparent &&
+                fill_span(target_row(t, py), l, r, values[index], &s0, &s1)) {
+                if (s0 < c0) c0 = s0;
+                if (s1 > c1) c1 = s1;
+            }
+            px += len;
+            n -= len;
+            if (px == img->w) {
+#if !DISPLAY_BAND_MODE
+                if (c1 >= 0) mark_dirty(t, c0, py, c1, py);
+#endif
+                c0 = TFT_WIDTH;
+                c1 = -1;
+                px = 0;
+                py++;
+            }
+        }
     }
-}*/
+}
 
-void display_draw_pixel(int16_t x, int16_t y, uint16_t color) {
-        framebuffer_set_pixel(x, y, color);
+// A glyph as row masks, from either 8 or 16-bit rows. Each stored row is
+// repeated 1 << row_shift times; left is the mask bit of the leftmost pixel.
+typedef struct {
+    const uint8_t *rows8;
+    const uint16_t *rows16;
+    int row_shift;
+    uint32_t left;
+    int w, h;                   // Pixels drawn, including any blank columns
+} glyph_src_t;
+
+// Writes glyph rows r0..r1, columns c0..c1 at x, y. The extent of the
+// changed pixels goes to *cx0..*cy1 (*cy0 < 0 if nothing changed).
+static inline __attribute__((always_inline))
+void glyph_rows(const raster_target_t *t, int x, int y, const glyph_src_t *g, int c0, int c1,
+                int r0, int r1, uint16_t color, uint16_t bg, int *cx0, int *cy0, int *cx1, int *cy1) {
+    display_fb_t fg = pixel_value(color);
+    display_fb_t bk = pixel_value(bg);
+    bool opaque = bg != color;
+
+    for (int r = r0; r <= r1; r++) {
+        uint32_t mask = g->rows8 ? g->rows8[r >> g->row_shift] : g->rows16[r >> g->row_shift];
+        display_fb_t *row = target_row(t, y + r);
+
+        int lo = TFT_WIDTH, hi = -1;
+        uint32_t bit = g->left >> c0;
+
+#pragma GCC unroll 16
+        for (int c = c0; c <= c1; c++, bit >>= 1) {
+            bool on = mask & bit;
+            if (!on && !opaque) continue;
+            if (row_put(row, x + c, on ? fg : bk)) {
+                if (lo > x + c) lo = x + c;
+                hi = x + c;
+            }
+        }
+        if (hi >= 0) {
+            if (lo < *cx0) *cx0 = lo;
+            if (hi > *cx1) *cx1 = hi;
+            if (*cy0 < 0) *cy0 = y + r;
+            *cy1 = y + r;
+        }
+    }
 }
 
-void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+// Written a row at a time; the changed pixels are marked dirty as one
+// rectangle. Inlined per call site, so a glyph of constant size that lies
+// fully inside the target runs with constant loop bounds.
+static RASTER_SPECIALISED void raster_glyph(const raster_target_t *t, int x, int y,
+                                            const glyph_src_t *g, uint16_t color, uint16_t bg) {
+    int cx0 = TFT_WIDTH, cx1 = -1, cy0 = -1, cy1 = -1;
+
+    if (x >= 0 && x + g->w <= TFT_WIDTH && y >= t->y0 && y + g->h - 1 <= t->y1) {
+        glyph_rows(t, x, y, g, 0, g->w - 1, 0, g->h - 1, color, bg, &cx0, &cy0, &cx1, &cy1);
+    } else {
+        int x0 = x, y0 = y, x1 = x + g->w - 1, y1 = y + g->h - 1;
+        if (!clip_rect(t, &x0, &y0, &x1, &y1)) return;
+        glyph_rows(t, x, y, g, x0 - x, x1 - x, y0 - y, y1 - y, color, bg, &cx0, &cy0, &cx1, &cy1);
+    }
+#if !DISPLAY_BAND_MODE
+    if (cy0 >= 0) mark_dirty(t, cx0, cy0, cx1, cy1);
+#else
+    (void)cx0; (void)cx1; (void)cy1;
+#endif
+}
+
+static RASTER_SPECIALISED void raster_char(const raster_target_t *t, int16_t x, int16_t y, char c,
+                                           uint16_t color, uint16_t bg, uint8_t size) {
     if (c < 32 || c > 126) c = 32; // Space for invalid chars
     
-    int char_index = c - 32;
+    // Nothing of the glyph inside the target rows
+    if (y > t->y1 || y + 7 * size <= t->y0) return;
     
-    for (int i = 0; i < 5; i++) {
-        uint8_t line = font5x7[char_index][i];
-        for (int j = 0; j < 7; j++) {
-            if (line & 0x01) {
-                if (size == 1) {
-                    framebuffer_set_pixel(x + i, y + j, color);
-                } else {
-                    for (int a = 0; a < size; a++) {
-                        for (int b = 0; b < size; b++) {
-                            framebuffer_set_pixel(x + (i * size) + a, y + (j * size) + b, color);
-                        }
-                    }
-                }
-            } else if (bg != color) {
-                if (size == 1) {
-                    framebuffer_set_pixel(x + i, y + j, bg);
-                } else {
-                    for (int a = 0; a < size; a++) {
-                        for (int b = 0; b < size; b++) {
-                            framebuffer_set_pixel(x + (i * size) + a, y + (j * size) + b, bg);
-                        }
-                    }
-                }
+    int glyph = c - FONT5X7_FIRST;
+    
+    if (size == 1) {
+        glyph_src_t g = { font_rows[glyph], NULL, 0, 0x10, 5, 7 };
+        raster_glyph(t, x, y, &g, color, bg);
+        return;
+    }
+    if (size == 2) {
+        glyph_src_t g = { NULL, font_rows2[glyph], 1, 0x200, 10, 14 };
+        raster_glyph(t, x, y, &g, color, bg);
+        return;
+    }
+    
+    // Larger sizes: every font pixel is a size x size block
+    for (int j = 0; j < 7; j++) {
+        uint8_t line = font_rows[glyph][j];
+        for (int i = 0; i < 5; i++) {
+            bool on = line & (0x10 >> i);
+            if (on || bg != color) {
+                raster_fill_rect(t, x + i * size, y + j * size, x + (i + 1) * size - 1,
+                                 y + (j + 1) * size - 1, on ? color : bg);
             }
-            line >>= 1;
         }
     }
 }
 
-void display_print_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
+static RASTER_SPECIALISED void raster_string(const raster_target_t *t, int16_t x, int16_t y,
+                                             const char *str, uint16_t color, uint16_t bg,
+                                             uint8_t size) {
     int16_t cursor_x = x;
     int16_t cursor_y = y;
     
@@ -508,7 +639,7 @@ void display_print_string(int16_t x, int16_t y, const char *str, uint16_t color,
         } else if (*str == '\r') {
             cursor_x = x;
         } else {
-            display_draw_char(cursor_x, cursor_y, *str, color, bg, size);
+            raster_char(t, cursor_x, cursor_y, *str, color, bg, size);
             cursor_x += size * 6;
             if (cursor_x > (TFT_WIDTH - size * 6)) {
                 cursor_x = x;
@@ -519,9 +650,492 @@ void display_print_string(int16_t x, int16_t y, const char *str, uint16_t color,
     }
 }
 
+// Proportional text. With an opaque background the spacing after each
+// glyph is filled too, so the text fully covers what was there.
+static RASTER_SPECIALISED void raster_text(const raster_target_t *t, int16_t x, int16_t y,
+                                           const char *str, const font_t *font,
+                                           uint16_t color, uint16_t bg) {
+    int cursor_x = x;
+    int cursor_y = y;
+    int pad = bg != color ? font->spacing : 0;
+
+    for (; *str; str++) {
+        if (*str == '\n') {
+            cursor_x = x;
+            cursor_y += font->line_height;
+            continue;
+        }
+        int c = (uint8_t)*str;
+        if (c < font->first || c >= font->first + font->count) c = ' ';
+        int glyph = c - font->first;
+        int w = font->widths[glyph];
+
+        if (cursor_y <= t->y1 && cursor_y + font->height > t->y0) {
+            glyph_src_t g = { NULL, &font->rows[glyph * font->height], 0, 0x8000, w + pad, font->height };
+            raster_glyph(t, cursor_x, cursor_y, &g, color, bg);
+        }
+        cursor_x += w + font->spacing;
+    }
+}
+
+#if DISPLAY_BAND_MODE
+typedef enum {
+    DL_FILL,
+    DL_PIXEL,
+    DL_CHAR,
+    DL_TEXT,
+    DL_RECT,
+    DL_BITMAP1,
+    DL_BITMAP16,
+    DL_FONT_TEXT,
+    DL_IMAGE
+} dl_op_t;
+
+typedef struct {
+    uint8_t op;
+    uint8_t size;
+    int16_t x, y;
+    int16_t w, h;               // Rectangles and bitmaps
+    uint16_t color;
+    uint16_t bg;
+    uint16_t arg;               // Character, or offset into dl_text
+    const void *data;           // Bitmap, font or image, must outlive the list
+} dl_cmd_t;
+
+static dl_cmd_t dl_cmds[DISPLAY_LIST_MAX_CMDS];
+static char dl_text[DISPLAY_LIST_TEXT_SIZE];
+static int dl_count = 0;
+static int dl_text_used = 0;
+static uint32_t dl_dropped = 0;        // Draw calls lost to a full list, logged at flush
+
+static const char *TAG = "DISPLAY";
+
+static dl_cmd_t *dl_alloc(dl_op_t op, int16_t x, int16_t y, uint16_t color, uint16_t bg) {
+    if (dl_count == DISPLAY_LIST_MAX_CMDS) {
+        dl_dropped++;
+        return NULL;
+    }
+    dl_cmd_t *cmd = &dl_cmds[dl_count++];
+    memset(cmd, 0, sizeof(*cmd));
+    cmd->op = op;
+    cmd->x = x;
+    cmd->y = y;
+    cmd->color = color;
+    cmd->bg = bg;
+    return cmd;
+}
+
+static void dl_record(dl_op_t op, int16_t x, int16_t y, uint16_t color, uint16_t bg,
+                      uint8_t size, uint16_t arg) {
+    dl_cmd_t *cmd = dl_alloc(op, x, y, color, bg);
+    if (cmd) {
+        cmd->size = size;
+        cmd->arg = arg;
+    }
+}
+
+// Copies str into the list's text pool. Returns its offset, or -1 if full.
+static int dl_store_text(const char *str) {
+    int len = strlen(str) + 1;
+    if (dl_text_used + len > DISPLAY_LIST_TEXT_SIZE) {
+        dl_dropped++;
+        return -1;
+    }
+    memcpy(&dl_text[dl_text_used], str, len);
+    dl_text_used += len;
+    return dl_text_used - len;
+}
+
+static void dl_record_block(dl_op_t op, int16_t x, int16_t y, int16_t w, int16_t h,
+                            uint16_t color, uint16_t bg, const void *data) {
+    dl_cmd_t *cmd = dl_alloc(op, x, y, color, bg);
+    if (cmd) {
+        cmd->w = w;
+        cmd->h = h;
+        cmd->data = data;
+    }
+}
+
+static void dl_replay(void) {
+    for (int i = 0; i < dl_count; i++) {
+        const dl_cmd_t *cmd = &dl_cmds[i];
+        switch (cmd->op) {
+            case DL_FILL:
+                raster_fill(&band_target, cmd->color);
+                break;
+            case DL_PIXEL:
+                put_pixel(&band_target, cmd->x, cmd->y, cmd->color);
+                break;
+            case DL_CHAR:
+                raster_char(&band_target, cmd->x, cmd->y, (char)cmd->arg, cmd->color, cmd->bg, cmd->size);
+                break;
+            case DL_TEXT:
+                raster_string(&band_target, cmd->x, cmd->y, &dl_text[cmd->arg], cmd->color, cmd->bg, cmd->size);
+                break;
+            case DL_RECT:
+                raster_fill_rect(&band_target, cmd->x, cmd->y, cmd->x + cmd->w - 1, cmd->y + cmd->h - 1, cmd->color);
+                break;
+            case DL_BITMAP1:
+                raster_bitmap1(&band_target, cmd->x, cmd->y, cmd->data, cmd->w, cmd->h, cmd->color, cmd->bg);
+                break;
+            case DL_BITMAP16:
+                raster_bitmap16(&band_target, cmd->x, cmd->y, cmd->data, cmd->w, cmd->h);
+                break;
+            case DL_FONT_TEXT:
+                raster_text(&band_target, cmd->x, cmd->y, &dl_text[cmd->arg], cmd->data, cmd->color, cmd->bg);
+                break;
+            case DL_IMAGE:
+                raster_image(&band_target, cmd->x, cmd->y, cmd->data);
+                break;
+        }
+    }
+}
+
+static uint32_t band_checksum(const uint16_t *band, int pixels) {
+    uint32_t h = 2166136261u;   // FNV-1a over 32-bit words
+    const uint32_t *w = (const uint32_t *)band;
+    for (int i = 0; i < pixels / 2; i++) {
+        h = (h ^ w[i]) * 16777619u;
+    }
+    return h;
+}
+#endif
+
+void framebuffer_set_pixel(int x, int y, uint16_t color) {
+#if DISPLAY_BAND_MODE
+    dl_record(DL_PIXEL, x, y, color, 0, 0, 0);
+#else
+    RASTER(put_pixel, x, y, color);
+#endif
+}
+
+void display_fill_screen(uint16_t color) {
+#if DISPLAY_BAND_MODE
+    // Covers everything recorded so far
+    dl_count = 0;
+    dl_text_used = 0;
+    dl_record(DL_FILL, 0, 0, color, 0, 0, 0);
+#else
+    RASTER(raster_fill, color);
+#endif
+}
+
+// Directs drawing to a layer. Drawing into a hidden overlay is dropped.
+void display_select_layer(display_layer_t layer) {
+#if !DISPLAY_BAND_MODE && DISPLAY_OVERLAY_ROWS
+    drawing_overlay = layer == DISPLAY_LAYER_OVERLAY;
+    overlay_target.y0 = overlay_y < 0 ? 0 : overlay_y;
+    overlay_target.y1 = overlay_y < 0 ? -1 : overlay_y + DISPLAY_OVERLAY_ROWS - 1;
+    layer_target = drawing_overlay ? &overlay_target : &fb_target;
+#else
+    (void)layer;
+#endif
+}
+
+// Shows the overlay strip at rows y..y + DISPLAY_OVERLAY_ROWS - 1. Its
+// contents are kept while hidden or moved and go out whole on the next flush.
+void display_overlay_show(int16_t y) {
+#if !DISPLAY_BAND_MODE && DISPLAY_OVERLAY_ROWS
+    if (y == overlay_y) return;
+    display_overlay_hide();
+    overlay_y = y;
+    dirty_region_add(&overlay_dirty, 0, y, TFT_WIDTH - 1, y + DISPLAY_OVERLAY_ROWS - 1);
+    display_select_layer(drawing_overlay ? DISPLAY_LAYER_OVERLAY : DISPLAY_LAYER_BACKGROUND);
+#else
+    (void)y;
+#endif
+}
+
+// The background rows under the strip have to be sent again
+void display_overlay_hide(void) {
+#if !DISPLAY_BAND_MODE && DISPLAY_OVERLAY_ROWS
+    if (overlay_y < 0) return;
+    bool was_overlay = drawing_overlay;
+    drawing_overlay = false;
+    mark_dirty(&fb_target, 0, overlay_y, TFT_WIDTH - 1, overlay_y + DISPLAY_OVERLAY_ROWS - 1);
+    overlay_y = -1;
+    dirty_region_clear(&overlay_dirty);
+    display_select_layer(was_overlay ? DISPLAY_LAYER_OVERLAY : DISPLAY_LAYER_BACKGROUND);
+#endif
+}
+
+// Makes rows y..y + h - 1 a hardware scroll area, shown unscrolled. h = 0
+// ends scrolling. Framebuffer rows stay where they are in panel RAM; the
+// panel shows them rotated within the area.
+void display_scroll_area(int16_t y, int16_t h) {
+    if (h <= 0) {
+        y = 0;
+        h = TFT_HEIGHT;
+    }
+    scroll.top = y;
+    scroll.height = h;
+    scroll.start = y;
+    scroll_changed = true;
+}
+
+// Shows framebuffer row start at the top of the scroll area, followed by
+// the rows below it, wrapping at the end of the area
+void display_scroll_to(int16_t start) {
+    if (start == scroll.start) return;
+    scroll.start = start;
+    scroll_changed = true;
+}
+
+// Hands a scroll change to the bus; it goes out after the pixels of the
+// flush that follows. Returns true if there was one.
+static bool scroll_flush(void) {
+    if (!scroll_changed || !DISPLAY_HW_SCROLL) return false;
+    scroll_changed = false;
+    flush_stats.command_bytes += DISPLAY_BUS_SCROLL_CMD_BYTES;
+    display_bus_scroll(&scroll);
+    return true;
+}
+
+// Starts sending the dirty region and returns straight away. cb runs once
+// the last pixel is out. Drawing must not touch the framebuffer until then;
+// use display_flush_wait() before the next frame.
+#if DISPLAY_BAND_MODE
+// In band mode the bands are rasterised here, on the caller, and only bands
+// whose contents changed since the last flush are sent.
+void display_flush_async(display_flush_cb_t cb, void *arg) {
+    int next = 0;
+
+    for (int b = 0; b < DISPLAY_BANDS; b++) {
+        band_target.fb = band_buf[next];
+        band_target.y0 = b * DISPLAY_BAND_ROWS;
+        band_target.y1 = band_target.y0 + DISPLAY_BAND_ROWS - 1;
+        if (band_target.y1 > TFT_HEIGHT - 1) band_target.y1 = TFT_HEIGHT - 1;
+
+        dl_replay();
+
+        int pixels = (band_target.y1 - band_target.y0 + 1) * TFT_WIDTH;
+        uint32_t sum = band_checksum(band_target.fb, pixels);
+        if (band_sum_valid && band_sum[b] == sum) continue;
+        band_sum[b] = sum;
+
+        flush_stats.windows++;
+        flush_stats.pixel_bytes += pixels * sizeof(uint16_t);
+        flush_stats.command_bytes += DISPLAY_BUS_WINDOW_CMD_BYTES;
+
+        // Blocks until the other buffer is out, then this one is in flight
+        display_bus_flush_rows(band_target.fb, band_target.y0, band_target.y1, NULL, NULL);
+        next ^= 1;
+    }
+    band_sum_valid = true;
+    flush_stats.flushes++;
+
+    // Whatever did not fit is missing from the frame
+    if (dl_dropped) {
+        ESP_LOGW(TAG, "Display list full: %lu draw calls dropped", (unsigned long)dl_dropped);
+        flush_stats.dropped += dl_dropped;
+        dl_dropped = 0;
+    }
+    scroll_flush();
+
+    // An empty flush queues behind the last band and reports completion
+    display_bus_flush(NULL, NULL, 0, cb, arg);
+}
+#else
+#if DISPLAY_OVERLAY_ROWS
+// The overlay's rectangles are appended after the background's
+_Static_assert(DIRTY_REGION_MAX_RECTS < DISPLAY_BUS_MAX_RECTS,
+               "DIRTY_REGION_MAX_RECTS leaves no room for the background on the bus");
+
+// Background rectangles lose the rows the overlay covers. One that spans
+// the whole strip is kept; the bus sends the strip rows from the overlay.
+static int trim_under_overlay(dirty_rect_t *rects, int count, int oy0, int oy1) {
+    int kept = 0;
+    for (int i = 0; i < count; i++) {
+        dirty_rect_t r = rects[i];
+        if (r.y0 >= oy0 && r.y1 <= oy1) continue;
+        if (r.y0 < oy0 && r.y1 >= oy0 && r.y1 <= oy1) r.y1 = oy0 - 1;
+        if (r.y0 >= oy0 && r.y0 <= oy1 && r.y1 > oy1) r.y0 = oy1 + 1;
+        rects[kept++] = r;
+    }
+    return kept;
+}
+
+// Adds the overlay's dirty rectangles and tells the bus where the strip is
+static int overlay_collect(dirty_rect_t *rects, int count) {
+    display_overlay_t ov = { NULL, 0, 0 };
+
+    if (overlay_y >= 0) {
+        ov.rows = overlay_fb;
+        ov.y0 = overlay_y;
+        ov.y1 = overlay_y + DISPLAY_OVERLAY_ROWS - 1;
+        count = trim_under_overlay(rects, count, ov.y0, ov.y1);
+        for (int i = 0; i < overlay_dirty.count; i++) {
+            rects[count++] = overlay_dirty.rects[i];
+        }
+    }
+    dirty_region_clear(&overlay_dirty);
+    display_bus_overlay(&ov);
+    return count;
+}
+#endif
+
+void display_flush_async(display_flush_cb_t cb, void *arg) {
+    dirty_rect_t rects[DISPLAY_BUS_MAX_RECTS];
+#if DISPLAY_OVERLAY_ROWS
+    int count = dirty_collect(rects, DISPLAY_BUS_MAX_RECTS - DIRTY_REGION_MAX_RECTS);
+    count = overlay_collect(rects, count);
+#else
+    int count = dirty_collect(rects, DISPLAY_BUS_MAX_RECTS);
+#endif
+    bool scrolled = scroll_flush();
+
+    if (count == 0 && !scrolled) {
+        if (cb) cb(arg);
+        return;
+    }
+
+    flush_stats.flushes++;
+    flush_stats.windows += count;
+    for (int i = 0; i < count; i++) {
+        flush_stats.pixel_bytes += (rects[i].x1 - rects[i].x0 + 1) * (rects[i].y1 - rects[i].y0 + 1) * sizeof(uint16_t);
+    }
+    flush_stats.command_bytes += count * DISPLAY_BUS_WINDOW_CMD_BYTES;
+
+    display_bus_flush(framebuffer, rects, count, cb, arg);
+    dirty_clear();
+}
+#endif
+
+// Blocks until no flush is in progress
+void display_flush_wait(void) {
+    display_bus_wait();
+}
+
+void display_flush_dirty(void) {
+    display_flush_async(NULL, NULL);
+    display_flush_wait();
+}
+
+void display_get_flush_stats(display_flush_stats_t *out) {
+    *out = flush_stats;
+}
+
+void display_reset_flush_stats(void) {
+    memset(&flush_stats, 0, sizeof(flush_stats));
+}
+
+void display_init(void) {
+    display_bus_init();
+
+#if DISPLAY_BAND_MODE
+    // Panel RAM is undefined after reset: send every band on the first flush
+    band_sum_valid = false;
+    display_fill_screen(BLACK);
+#else
+#if DISPLAY_FB_BPP == 4
+    for (int i = 0; i < 16; i++) {
+        palette_update_pairs(i);
+    }
+#endif
+
+    // Panel RAM is undefined after reset, send the whole cleared frame
+    dirty_clear();
+    display_fill_screen(BLACK);
+    mark_dirty(&fb_target, 0, 0, TFT_WIDTH - 1, TFT_HEIGHT - 1);
+#endif
+}
+
+void display_draw_pixel(int16_t x, int16_t y, uint16_t color) {
+        framebuffer_set_pixel(x, y, color);
+}
+
+void display_draw_char(int16_t x, int16_t y, char c, uint16_t color, uint16_t bg, uint8_t size) {
+#if DISPLAY_BAND_MODE
+    dl_record(DL_CHAR, x, y, color, bg, size, (uint8_t)c);
+#else
+    RASTER(raster_char, x, y, c, color, bg, size);
+#endif
+}
+
+void display_print_string(int16_t x, int16_t y, const char *str, uint16_t color, uint16_t bg, uint8_t size) {
+#if DISPLAY_BAND_MODE
+    int offset = dl_store_text(str);
+    if (offset >= 0) dl_record(DL_TEXT, x, y, color, bg, size, offset);
+#else
+    RASTER(raster_string, x, y, str, color, bg, size);
+#endif
+}
+
+// Draws str in a proportional font; '\n' starts a new line at x
+void display_draw_text(int16_t x, int16_t y, const char *str, const font_t *font,
+                       uint16_t color, uint16_t bg) {
+#if DISPLAY_BAND_MODE
+    int offset = dl_store_text(str);
+    if (offset < 0) return;
+    dl_cmd_t *cmd = dl_alloc(DL_FONT_TEXT, x, y, color, bg);
+    if (cmd) {
+        cmd->arg = offset;
+        cmd->data = font;
+    }
+#else
+    RASTER(raster_text, x, y, str, font, color, bg);
+#endif
+}
+
+void display_fill_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+#if DISPLAY_BAND_MODE
+    dl_record_block(DL_RECT, x, y, w, h, color, 0, NULL);
+#else
+    RASTER(raster_fill_rect, x, y, x + w - 1, y + h - 1, color);
+#endif
+}
+
+void display_draw_hline(int16_t x, int16_t y, int16_t w, uint16_t color) {
+    display_fill_rect(x, y, w, 1, color);
+}
+
+void display_draw_vline(int16_t x, int16_t y, int16_t h, uint16_t color) {
+    display_fill_rect(x, y, 1, h, color);
+}
+
+// One pixel outline
+void display_draw_rect(int16_t x, int16_t y, int16_t w, int16_t h, uint16_t color) {
+    if (w <= 0 || h <= 0) return;
+    display_draw_hline(x, y, w, color);
+    if (h > 1) display_draw_hline(x, y + h - 1, w, color);
+    if (h > 2) {
+        display_draw_vline(x, y + 1, h - 2, color);
+        if (w > 1) display_draw_vline(x + w - 1, y + 1, h - 2, color);
+    }
+}
+
+void display_draw_bitmap1(int16_t x, int16_t y, const uint8_t *bits, int16_t w, int16_t h,
+                          uint16_t color, uint16_t bg) {
+    if (w <= 0 || h <= 0) return;
+#if DISPLAY_BAND_MODE
+    dl_record_block(DL_BITMAP1, x, y, w, h, color, bg, bits);
+#else
+    RASTER(raster_bitmap1, x, y, bits, w, h, color, bg);
+#endif
+}
+
+void display_draw_bitmap16(int16_t x, int16_t y, const uint16_t *pixels, int16_t w, int16_t h) {
+    if (w <= 0 || h <= 0) return;
+#if DISPLAY_BAND_MODE
+    dl_record_block(DL_BITMAP16, x, y, w, h, 0, 0, pixels);
+#else
+    RASTER(raster_bitmap16, x, y, pixels, w, h);
+#endif
+}
+
+// img must outlive the display list in band mode
+void display_draw_image(int16_t x, int16_t y, const image_t *img) {
+#if DISPLAY_BAND_MODE
+    dl_record_block(DL_IMAGE, x, y, img->w, img->h, 0, 0, img);
+#else
+    RASTER(raster_image, x, y, img);
+#endif
+}
+
 void display_welcome(void) {
     display_fill_screen(BLACK);
-    display_print_string(10, 50, "FOCUS RAIL", WHITE, BLACK, 2);
-    display_print_string(10, 70, "CONTROLLER", WHITE, BLACK, 2);
+    display_draw_text(10, 50, "FOCUS RAIL", &font_large, WHITE, BLACK);
+    display_draw_text(10, 70, "CONTROLLER", &font_large, WHITE, BLACK);
     display_print_string(10, 100, "Initializing...", YELLOW, BLACK, 1);
-}
\ No newline at end of file
+}
@@ -0,0 +1,388 @@
+#include <stdio.h>
+#include <stdint.h>
+#include <string.h>
+#include <assert.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "freertos/semphr.h"
+#include "driver/gpio.h"
+#include "driver/spi_master.h"
+#include "esp_heap_caps.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+#include "esp_attr.h"
+#include "esp_rom_sys.h"
+
+#include "display.h"
+#include "display_bus.h"
+
+static const char *TAG = "DISPLAY";
+
+// Flush pipeline. Full-width rectangles of an RGB565 framebuffer are
+// contiguous and go out straight from it. Everything else is gathered into
+// DMA-capable band buffers, expanding palette indices on the way, and queued
+// so the next band is prepared while the previous one is clocked out.
+#define FLUSH_BUF_COUNT     3
+#define FLUSH_BAND_ROWS     8
+
+typedef struct {
+    const display_fb_t *fb;
+    dirty_rect_t rects[DISPLAY_BUS_MAX_RECTS];
+    int count;
+    const uint16_t *rows;       // Full-width rows rows_y0..rows_y1, if set
+    int rows_y0, rows_y1;
+    display_overlay_t overlay;
+    display_scroll_t scroll;    // Sent after the pixels, if scroll_pending
+    bool scroll_pending;
+    display_flush_cb_t cb;
+    void *arg;
+} flush_request_t;
+
+static uint16_t *flush_buf[FLUSH_BUF_COUNT];
+static spi_transaction_t flush_trans[FLUSH_BUF_COUNT];
+static flush_request_t flush_req;
+static TaskHandle_t flush_task_handle = NULL;
+static SemaphoreHandle_t flush_idle = NULL;
+
+// Scroll change and overlay for the next display_bus_flush()
+static display_scroll_t scroll_next;
+static bool scroll_next_pending = false;
+static display_overlay_t overlay_next;
+
+// Command stream. DC is set from each transaction's user field in the SPI
+// pre-transfer callback, so a command and its parameter block are two
+// back-to-back transactions that can be queued without waiting in between.
+#define DC_COMMAND          ((void *)0)
+#define DC_DATA             ((void *)1)
+
+// CASET + params, RASET + params, RAMWR
+#define WINDOW_TRANS        5
+
+// Global variables
+static spi_device_handle_t spi;
+static const panel_t *panel;
+static spi_transaction_t window_trans[WINDOW_TRANS];
+static int trans_in_flight = 0;
+
+// Function prototypes
+static void tft_pre_transfer_cb(spi_transaction_t *t);
+static void tft_queue(spi_transaction_t *t);
+static void tft_wait(spi_transaction_t *t);
+static void tft_queue_addr_window(int x0, int y0, int x1, int y1);
+static void tft_send_scroll(const display_scroll_t *scroll);
+static void tft_send_command(uint8_t cmd, const uint8_t *args, int count);
+static void tft_send_init_table(const uint8_t *addr);
+static void tft_delay_ms(int ms);
+
+// Zero copy: full-width rows are contiguous and already in panel byte order
+static void flush_rows(const uint16_t *rows, int y0, int y1) {
+    tft_queue_addr_window(0, y0, TFT_WIDTH - 1, y1);
+
+    spi_transaction_t *t = &flush_trans[0];
+    memset(t, 0, sizeof(*t));
+    t->length = TFT_WIDTH * (y1 - y0 + 1) * 16;  // bits (16 bits per pixel)
+    t->tx_buffer = rows;
+    t->user = DC_DATA;
+    tft_queue(t);
+    tft_wait(NULL);
+}
+
+static void flush_rect(const display_fb_t *fb, const display_overlay_t *ov,
+                       const dirty_rect_t *rect) {
+    int w = rect->x1 - rect->x0 + 1;
+    int queued = 0;
+    int next = 0;
+
+#if !DISPLAY_FB_INDEXED
+    if (w == TFT_WIDTH && display_bus_rows_contiguous(ov, rect->y0, rect->y1)) {
+        flush_rows(display_bus_row(fb, ov, rect->y0), rect->y0, rect->y1);
+        return;
+    }
+#endif
+
+    // Queued ahead of the pixels; the previous rect drained its window
+    tft_queue_addr_window(rect->x0, rect->y0, rect->x1, rect->y1);
+
+    for (int y = rect->y0; y <= rect->y1; y += FLUSH_BAND_ROWS) {
+        int rows = rect->y1 - y + 1;
+        if (rows > FLUSH_BAND_ROWS) rows = FLUSH_BAND_ROWS;
+
+        // All buffers in flight: wait for the oldest one to go out
+        if (queued == FLUSH_BUF_COUNT) {
+            tft_wait(&flush_trans[next]);
+            queued--;
+        }
+
+        uint16_t *dst = flush_buf[next];
+        // Overlay rows are composited here, on the way into the DMA buffer
+        for (int r = 0; r < rows; r++) {
+            display_fb_expand(dst + r * w, display_bus_row(fb, ov, y + r), rect->x0, 0, w);
+        }
+
+        spi_transaction_t *t = &flush_trans[next];
+        memset(t, 0, sizeof(*t));
+        t->length = w * rows * 16;  // bits (16 bits per pixel)
+        t->tx_buffer = dst;
+        t->user = DC_DATA;
+        tft_queue(t);
+        queued++;
+        next = (next + 1) % FLUSH_BUF_COUNT;
+    }
+
+    tft_wait(NULL);
+}
+
+static void flush_task(void *pvParameters) {
+    while (1) {
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+
+        if (flush_req.rows) {
+            flush_rows(flush_req.rows, flush_req.rows_y0, flush_req.rows_y1);
+        }
+        for (int i = 0; i < flush_req.count; i++) {
+            flush_rect(flush_req.fb, &flush_req.overlay, &flush_req.rects[i]);
+        }
+        // After the pixels, so newly exposed rows are in place when they show
+        if (flush_req.scroll_pending) {
+            tft_send_scroll(&flush_req.scroll);
+        }
+        if (flush_req.cb) {
+            flush_req.cb(flush_req.arg);
+        }
+        xSemaphoreGive(flush_idle);
+    }
+}
+
+// Sends count rectangles of fb. Waits for a flush still in
+// progress, then returns as soon as the new one is started; cb runs on the
+// flush task once the last pixel is out.
+void display_bus_flush(const display_fb_t *fb, const dirty_rect_t *rects, int count,
+                       display_flush_cb_t cb, void *arg) {
+    xSemaphoreTake(flush_idle, portMAX_DELAY);
+
+    flush_req.fb = fb;
+    memcpy(flush_req.rects, rects, count * sizeof(dirty_rect_t));
+    flush_req.count = count;
+    flush_req.rows = NULL;
+    flush_req.overlay = overlay_next;
+    flush_req.scroll = scroll_next;
+    flush_req.scroll_pending = scroll_next_pending;
+    scroll_next_pending = false;
+    flush_req.cb = cb;
+    flush_req.arg = arg;
+
+    xTaskNotifyGive(flush_task_handle);
+}
+
+// Sends full-width rows y0..y1 from a buffer holding only those rows. The
+// buffer must stay untouched until the flush completes.
+void display_bus_flush_rows(const uint16_t *rows, int y0, int y1,
+                            display_flush_cb_t cb, void *arg) {
+    xSemaphoreTake(flush_idle, portMAX_DELAY);
+
+    flush_req.count = 0;
+    flush_req.scroll_pending = false;
+    flush_req.rows = rows;
+    flush_req.rows_y0 = y0;
+    flush_req.rows_y1 = y1;
+    flush_req.cb = cb;
+    flush_req.arg = arg;
+
+    xTaskNotifyGive(flush_task_handle);
+}
+
+// Blocks until no flush is in progress
+void display_bus_wait(void) {
+    xSemaphoreTake(flush_idle, portMAX_DELAY);
+    xSemaphoreGive(flush_idle);
+}
+
+// Used by the following display_bus_flush() calls
+void display_bus_overlay(const display_overlay_t *overlay) {
+    overlay_next = *overlay;
+}
+
+// Applied after the pixels of the next display_bus_flush()
+void display_bus_scroll(const display_scroll_t *scroll) {
+    scroll_next = *scroll;
+    scroll_next_pending = true;
+}
+
+void display_bus_init(void) {
+    esp_err_t ret;
+    
+    // Initialize SPI bus
+    spi_bus_config_t buscfg = {
+        .miso_io_num = -1,
+        .mosi_io_num = TFT_MOSI_PIN,
+        .sclk_io_num = TFT_SCLK_PIN,
+        .quadwp_io_num = -1,
+        .quadhd_io_num = -1,
+        .max_transfer_sz = TFT_WIDTH * TFT_HEIGHT * 2
+    };
+    
+    panel = panel_get();
+
+    ret = spi_bus_initialize(HSPI_HOST, &buscfg, SPI_DMA_CH_AUTO);
+    ESP_ERROR_CHECK(ret);
+    
+    // Initialize SPI device
+    spi_device_interface_config_t devcfg = {
+        .clock_speed_hz = panel->spi_clock_hz,
+        .mode = 0,
+        .spics_io_num = TFT_CS_PIN,
+        .queue_size = WINDOW_TRANS + FLUSH_BUF_COUNT,
+        .pre_cb = tft_pre_transfer_cb,
+    };
+    
+    ret = spi_bus_add_device(HSPI_HOST, &devcfg, &spi);
+    ESP_ERROR_CHECK(ret);
+    
+    // Flush band buffers must be DMA-capable
+    for (int i = 0; i < FLUSH_BUF_COUNT; i++) {
+        flush_buf[i] = heap_caps_malloc(TFT_WIDTH * FLUSH_BAND_ROWS * sizeof(uint16_t), MALLOC_CAP_DMA);
+        assert(flush_buf[i] != NULL);
+    }
+    flush_idle = xSemaphoreCreateBinary();
+    xSemaphoreGive(flush_idle);
+    xTaskCreate(flush_task, "flush_task", 2048, NULL, 7, &flush_task_handle);
+    
+    // Configure control pins
+    gpio_config_t io_conf = {};
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.mode = GPIO_MODE_OUTPUT;
+    io_conf.pin_bit_mask = (1ULL << TFT_DC_PIN) | (1ULL << TFT_RST_PIN);
+    io_conf.pull_down_en = 0;
+    io_conf.pull_up_en = 0;
+    gpio_config(&io_conf);
+    
+    // Reset display: at least 10 us low, then 120 ms until it takes commands.
+    // Busy-wait the pulse: a tick delay may end microseconds later.
+    gpio_set_level(TFT_RST_PIN, 0);
+    esp_rom_delay_us(10);
+    gpio_set_level(TFT_RST_PIN, 1);
+    tft_delay_ms(120);
+    
+    int64_t start = esp_timer_get_time();
+    tft_send_init_table(panel->init_cmds);
+    tft_send_command(ST77XX_MADCTL, &panel->madctl[DISPLAY_ROTATION], 1);
+    ESP_LOGI(TAG, "%s %dx%d initialized, init table took %lld ms", panel->name,
+             TFT_WIDTH, TFT_HEIGHT, (long long)(esp_timer_get_time() - start) / 1000);
+}
+
+static void IRAM_ATTR tft_pre_transfer_cb(spi_transaction_t *t) {
+    gpio_set_level(TFT_DC_PIN, (int)(intptr_t)t->user);
+}
+
+static void tft_queue(spi_transaction_t *t) {
+    ESP_ERROR_CHECK(spi_device_queue_trans(spi, t, portMAX_DELAY));
+    trans_in_flight++;
+}
+
+// Collects finished transactions until t is done, or all of them for NULL
+static void tft_wait(spi_transaction_t *t) {
+    while (trans_in_flight > 0) {
+        spi_transaction_t *done;
+        ESP_ERROR_CHECK(spi_device_get_trans_result(spi, &done, portMAX_DELAY));
+        trans_in_flight--;
+        if (done == t) return;
+    }
+}
+
+// Up to four bytes travel in the transaction itself, no buffer needed
+static void tft_set_trans(spi_transaction_t *t, void *dc, const uint8_t *bytes, int count) {
+    memset(t, 0, sizeof(*t));
+    t->flags = SPI_TRANS_USE_TXDATA;
+    t->length = count * 8;
+    t->user = dc;
+    memcpy(t->tx_data, bytes, count);
+}
+
+// Queues CASET, RASET and RAMWR as five transactions. The window
+// transactions are reused, so the previous window must have completed.
+static void tft_queue_addr_window(int x0, int y0, int x1, int y1) {
+    const uint8_t caset = ST77XX_CASET, raset = ST77XX_RASET, ramwr = ST77XX_RAMWR;
+    uint8_t cols[4], rows[4];
+
+    panel_window(panel, x0, y0, x1, y1, cols, rows);
+
+    tft_set_trans(&window_trans[0], DC_COMMAND, &caset, 1);
+    tft_set_trans(&window_trans[1], DC_DATA, cols, 4);
+    tft_set_trans(&window_trans[2], DC_COMMAND, &raset, 1);
+    tft_set_trans(&window_trans[3], DC_DATA, rows, 4);
+    tft_set_trans(&window_trans[4], DC_COMMAND, &ramwr, 1);
+
+    for (int i = 0; i < WINDOW_TRANS; i++) {
+        tft_queue(&window_trans[i]);
+    }
+}
+
+// VSCRDEF and VSCRSADD, queued on the window transactions. VSCRDEF's six
+// parameter bytes do not fit into tx_data.
+static void tft_send_scroll(const display_scroll_t *scroll) {
+    static uint8_t vscrdef[6] __attribute__((aligned(4)));
+    const uint8_t def_cmd = ST77XX_VSCRDEF, sadd_cmd = ST77XX_VSCRSADD;
+    uint8_t vscrsadd[2];
+
+    panel_scroll(panel, scroll->top, scroll->height, scroll->start, vscrdef, vscrsadd);
+
+    tft_set_trans(&window_trans[0], DC_COMMAND, &def_cmd, 1);
+    memset(&window_trans[1], 0, sizeof(window_trans[1]));
+    window_trans[1].length = sizeof(vscrdef) * 8;
+    window_trans[1].tx_buffer = vscrdef;
+    window_trans[1].user = DC_DATA;
+    tft_set_trans(&window_trans[2], DC_COMMAND, &sadd_cmd, 1);
+    tft_set_trans(&window_trans[3], DC_DATA, vscrsadd, 2);
+
+    for (int i = 0; i < 4; i++) {
+        tft_queue(&window_trans[i]);
+    }
+    tft_wait(NULL);
+}
+
+// One command and its arguments as two polling transactions
+static void tft_send_command(uint8_t cmd, const uint8_t *args, int count) {
+    spi_transaction_t t;
+
+    tft_set_trans(&t, DC_COMMAND, &cmd, 1);
+    ESP_ERROR_CHECK(spi_device_polling_transmit(spi, &t));
+    if (count == 0) return;
+
+    if (count <= 4) {
+        tft_set_trans(&t, DC_DATA, args, count);
+    } else {
+        // Longer argument lists go through a DMA-capable buffer; the flush
+        // buffers are idle while commands are sent
+        memcpy(flush_buf[0], args, count);
+        memset(&t, 0, sizeof(t));
+        t.length = count * 8;
+        t.tx_buffer = flush_buf[0];
+        t.user = DC_DATA;
+    }
+    ESP_ERROR_CHECK(spi_device_polling_transmit(spi, &t));
+}
+
+static void tft_send_init_table(const uint8_t *addr) {
+    int commands = *addr++;
+
+    while (commands--) {
+        uint8_t cmd = *addr++;
+        uint8_t count = *addr++;
+        bool delay = count & PANEL_INIT_DELAY;
+        count &= ~PANEL_INIT_DELAY;
+
+        tft_send_command(cmd, addr, count);
+        addr += count;
+
+        if (delay) {
+            int ms = *addr++;
+            tft_delay_ms(ms == 255 ? 500 : ms);
+        }
+    }
+}
+
+// Waits at least ms. pdMS_TO_TICKS() rounds down and the first tick may come
+// right away, so round up and add one: at 100 Hz a 10 ms wait is 2 ticks.
+static void tft_delay_ms(int ms) {
+    vTaskDelay(pdMS_TO_TICKS(ms + portTICK_PERIOD_MS - 1) + 1);
+}
@@ -11,12 +11,21 @@
 
 static const char *TAG = "ENCODER";
 
+#define ENCODER_QUEUE_LEN   32
+
 // Global variables
 QueueHandle_t encoder_queue;
 
-// Rotary encoder ISR handler (handles both A and B pins)
+static const encoder_accel_point_t accel_curve[] = ENCODER_ACCEL_CURVE;
+
+#define ACCEL_POINTS        ((int)(sizeof(accel_curve) / sizeof(accel_curve[0])))
+
+// Rotary encoder ISR handler (handles both A and B pins). Counts valid
+// quadrature transitions and reports one detent when the encoder is back at
+// rest, so contact bounce cancels out and the count resyncs at every detent.
 static void IRAM_ATTR encoder_rotary_isr_handler(void *arg) {
-    static uint8_t last_state = 0;
+    static uint8_t last_state = ENCODER_REST_STATE;
+    static int8_t transitions = 0;
     static const int8_t transition_table[16] = {
         0, -1,  1,  0,
         1,  0,  0, -1,
@@ -30,12 +39,21 @@ static void IRAM_ATTR encoder_rotary_isr_handler(void *arg) {
     uint8_t current_state = (a << 1) | b;
     uint8_t state_transition = (last_state << 2) | current_state;
 
-    int8_t direction = transition_table[state_transition & 0x0F];
+    transitions += transition_table[state_transition & 0x0F];
     last_state = current_state;
 
+    if (current_state != ENCODER_REST_STATE) return;
+
+    // A detent is a full cycle of four transitions; accept it once more than
+    // half of them were seen
+    int8_t direction = transitions >= 2 ? 1 : (transitions <= -2 ? -1 : 0);
+    transitions = 0;
+
     if (direction != 0) {
         encoder_event_t event = {0};
-        event.direction = direction;
+        event.delta = direction;
+        event.detents = direction;
+        event.time_us = (uint32_t)esp_timer_get_time();
         BaseType_t xHigherPriorityTaskWoken = pdFALSE;
         xQueueSendFromISR(encoder_queue, &event, &xHigherPriorityTaskWoken);
         if (xHigherPriorityTaskWoken) {
@@ -94,46 +112,69 @@ void encoder_init(void) {
     gpio_isr_handler_add(ENCODER_SW_PIN, encoder_switch_isr_handler, (void*)ENCODER_SW_PIN);
 
     // Create the queue to hold encoder events
-    encoder_queue = xQueueCreate(10, sizeof(encoder_event_t));
+    encoder_queue = xQueueCreate(ENCODER_QUEUE_LEN, sizeof(encoder_event_t));
 
     ESP_LOGI(TAG, "Encoder initialized");
 }
 
+// Gain for a detent interval_us after the previous one, from the curve
+static int accel_gain(uint32_t interval_us) {
+    uint32_t ms = interval_us / 1000;
+
+    if (ms >= accel_curve[0].interval_ms) return accel_curve[0].gain;
+    for (int i = 1; i < ACCEL_POINTS; i++) {
+        const encoder_accel_point_t *slow = &accel_curve[i - 1];
+        const encoder_accel_point_t *fast = &accel_curve[i];
+        if (ms >= fast->interval_ms) {
+            // Linear between the two points, rounded
+            int span = slow->interval_ms - fast->interval_ms;
+            int into = slow->interval_ms - ms;
+            return slow->gain + ((fast->gain - slow->gain) * into + span / 2) / span;
+        }
+    }
+    return accel_curve[ACCEL_POINTS - 1].gain;
+}
+
+// Turns detents into signed deltas. Every detent counts: a detent follows
+// right away, together with any others that queued up meanwhile (for
+// example while a move was running), so nothing is dropped or delayed.
 void encoder_task(void *pvParameters) {
     encoder_event_t event;
+    uint32_t last_detent_us = 0;
+    int last_direction = 0;
 
     ESP_LOGI(TAG, "Encoder task started");
 
-    int accumulated_direction = 0;
-    int64_t last_event_time = 0;
-    const int64_t aggregation_timeout_ms = 150;
-
     while (1) {
-        if (xQueueReceive(encoder_queue, &event, pdMS_TO_TICKS(aggregation_timeout_ms))) {
-            if (event.direction != 0) {
-                accumulated_direction += event.direction;
-                last_event_time = esp_timer_get_time() / 1000;
-                ESP_LOGI(TAG, "Accumulated direction: %d", accumulated_direction);
-            } else if (event.button_pressed) {
-                // Flush any accumulated direction before handling button
-                if (accumulated_direction != 0) {
-                    encoder_event_t dir_event = {0};
-                    dir_event.direction = (accumulated_direction > 0) ? 1 : -1;
-                    menu_handle_input(&dir_event);
-                    accumulated_direction = 0;
-                }
-                ESP_LOGI(TAG, "Button pressed");
-                menu_handle_input(&event);
+        xQueueReceive(encoder_queue, &event, portMAX_DELAY);
+
+        encoder_event_t turn = {0};
+        bool button = false;
+        do {
+            if (event.button_pressed) {
+                button = true;
+                break;
             }
-        } else {
-            // Timeout occurred, no new events: handle accumulated direction if any
-            if (accumulated_direction != 0) {
-                encoder_event_t dir_event = {0};
-                dir_event.direction = (accumulated_direction > 0) ? 1 : -1;
-                ESP_LOGI(TAG, "Processing accumulated direction: %d", dir_event.direction);
-                menu_handle_input(&dir_event);
-                accumulated_direction = 0;
+            // A reversal starts again from single steps
+            int gain = 1;
+            if (event.detents == last_direction) {
+                gain = accel_gain(event.time_us - last_detent_us);
             }
+            last_direction = event.detents;
+            last_detent_us = event.time_us;
+
+            turn.delta += event.detents * gain;
+            turn.detents += event.detents;
+            turn.time_us = event.time_us;
+        } while (xQueueReceive(encoder_queue, &event, 0));
+
+        if (turn.delta != 0 || turn.detents != 0) {
+            ESP_LOGD(TAG, "Turn: %d detents, delta %d", turn.detents, turn.delta);
+            menu_handle_input(&turn);
+        }
+        if (button) {
+            ESP_LOGI(TAG, "Button pressed");
+            menu_handle_input(&event);
         }
     }
-}
\ No newline at end of file
+}
@@ -0,0 +1,21 @@
+#include <limits.h>
+
+#include "font.h"
+
+// Pen movement after the first n characters of str (or all, if shorter)
+int font_text_advance(const font_t *font, const char *str, int n) {
+    int w = 0;
+
+    for (; *str && n > 0; str++, n--) {
+        int c = (uint8_t)*str;
+        if (c < font->first || c >= font->first + font->count) c = ' ';
+        w += font->widths[c - font->first] + font->spacing;
+    }
+    return w;
+}
+
+// Width in pixels of a single line of text, without the trailing spacing
+int font_text_width(const font_t *font, const char *str) {
+    int w = font_text_advance(font, str, INT_MAX);
+    return w > 0 ? w - font->spacing : 0;
+}
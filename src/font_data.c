@@ -0,0 +1,239 @@
+// Generated by tools/fontgen/fontgen.py from include/font5x7.h. Do not edit.
+
+#include <stdint.h>
+
+#include "font.h"
+
+static const uint8_t font_small_widths[95] = {
+    3, 1, 3, 5, 5, 5, 5, 2, 3, 3, 5, 5, 2, 5, 2, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 2, 2, 4, 5, 4, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 5, 5, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 5, 3, 5, 5,
+    3, 5, 5, 5, 5, 5, 5, 5, 5, 3, 4, 4, 3, 5, 5, 5,
+    5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 5, 3, 1, 3, 5,
+};
+
+static const uint16_t font_small_rows[95 * 7] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // ' '
+    0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x0000, 0x8000, // '!'
+    0xA000, 0xA000, 0xA000, 0x0000, 0x0000, 0x0000, 0x0000, // '"'
+    0x5000, 0x5000, 0xF800, 0x5000, 0xF800, 0x5000, 0x5000, // '#'
+    0x2000, 0x7800, 0xA000, 0x7000, 0x2800, 0xF000, 0x2000, // '$'
+    0xC000, 0xC800, 0x1000, 0x2000, 0x4000, 0x9800, 0x1800, // '%'
+    0x6000, 0x9000, 0xA000, 0x4000, 0xA800, 0x9000, 0x6800, // '&'
+    0xC000, 0x4000, 0x8000, 0x0000, 0x0000, 0x0000, 0x0000, // '''
+    0x2000, 0x4000, 0x8000, 0x8000, 0x8000, 0x4000, 0x2000, // '('
+    0x8000, 0x4000, 0x2000, 0x2000, 0x2000, 0x4000, 0x8000, // ')'
+    0x0000, 0x2000, 0xA800, 0x7000, 0xA800, 0x2000, 0x0000, // '*'
+    0x0000, 0x2000, 0x2000, 0xF800, 0x2000, 0x2000, 0x0000, // '+'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC000, 0x4000, 0x8000, // ','
+    0x0000, 0x0000, 0x0000, 0xF800, 0x0000, 0x0000, 0x0000, // '-'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xC000, 0xC000, // '.'
+    0x0000, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000, 0x0000, // '/'
+    0x7000, 0x8800, 0x9800, 0xA800, 0xC800, 0x8800, 0x7000, // '0'
+    0x2000, 0x6000, 0x2000, 0x2000, 0x2000, 0x2000, 0x7000, // '1'
+    0x7000, 0x8800, 0x0800, 0x1000, 0x2000, 0x4000, 0xF800, // '2'
+    0xF800, 0x1000, 0x2000, 0x1000, 0x0800, 0x8800, 0x7000, // '3'
+    0x1000, 0x3000, 0x5000, 0x9000, 0xF800, 0x1000, 0x1000, // '4'
+    0xF800, 0x8000, 0xF000, 0x0800, 0x0800, 0x8800, 0x7000, // '5'
+    0x3000, 0x4000, 0x8000, 0xF000, 0x8800, 0x8800, 0x7000, // '6'
+    0xF800, 0x0800, 0x1000, 0x2000, 0x4000, 0x4000, 0x4000, // '7'
+    0x7000, 0x8800, 0x8800, 0x7000, 0x8800, 0x8800, 0x7000, // '8'
+    0x7000, 0x8800, 0x8800, 0x7800, 0x0800, 0x1000, 0x6000, // '9'
+    0x0000, 0xC000, 0xC000, 0x0000, 0xC000, 0xC000, 0x0000, // ':'
+    0x0000, 0xC000, 0xC000, 0x0000, 0xC000, 0x4000, 0x8000, // ';'
+    0x1000, 0x2000, 0x4000, 0x8000, 0x4000, 0x2000, 0x1000, // '<'
+    0x0000, 0x0000, 0xF800, 0x0000, 0xF800, 0x0000, 0x0000, // '='
+    0x8000, 0x4000, 0x2000, 0x1000, 0x2000, 0x4000, 0x8000, // '>'
+    0x7000, 0x8800, 0x0800, 0x1000, 0x2000, 0x0000, 0x2000, // '?'
+    0x7000, 0x8800, 0x0800, 0x6800, 0xA800, 0xA800, 0x7000, // '@'
+    0x7000, 0x8800, 0x8800, 0x8800, 0xF800, 0x8800, 0x8800, // 'A'
+    0xF000, 0x8800, 0x8800, 0xF000, 0x8800, 0x8800, 0xF000, // 'B'
+    0x7000, 0x8800, 0x8000, 0x8000, 0x8000, 0x8800, 0x7000, // 'C'
+    0xE000, 0x9000, 0x8800, 0x8800, 0x8800, 0x9000, 0xE000, // 'D'
+    0xF800, 0x8000, 0x8000, 0xF000, 0x8000, 0x8000, 0xF800, // 'E'
+    0xF800, 0x8000, 0x8000, 0xF000, 0x8000, 0x8000, 0x8000, // 'F'
+    0x7000, 0x8800, 0x8000, 0xB800, 0x8800, 0x8800, 0x7800, // 'G'
+    0x8800, 0x8800, 0x8800, 0xF800, 0x8800, 0x8800, 0x8800, // 'H'
+    0xE000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0xE000, // 'I'
+    0x3800, 0x1000, 0x1000, 0x1000, 0x1000, 0x9000, 0x6000, // 'J'
+    0x8800, 0x9000, 0xA000, 0xC000, 0xA000, 0x9000, 0x8800, // 'K'
+    0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0xF800, // 'L'
+    0x8800, 0xD800, 0xA800, 0xA800, 0x8800, 0x8800, 0x8800, // 'M'
+    0x8800, 0x8800, 0xC800, 0xA800, 0x9800, 0x8800, 0x8800, // 'N'
+    0x7000, 0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x7000, // 'O'
+    0xF000, 0x8800, 0x8800, 0xF000, 0x8000, 0x8000, 0x8000, // 'P'
+    0x7000, 0x8800, 0x8800, 0x8800, 0xA800, 0x9000, 0x6800, // 'Q'
+    0xF000, 0x8800, 0x8800, 0xF000, 0xA000, 0x9000, 0x8800, // 'R'
+    0x7800, 0x8000, 0x8000, 0x7000, 0x0800, 0x0800, 0xF000, // 'S'
+    0xF800, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, // 'T'
+    0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x7000, // 'U'
+    0x8800, 0x8800, 0x8800, 0x8800, 0x8800, 0x5000, 0x2000, // 'V'
+    0x8800, 0x8800, 0x8800, 0xA800, 0xA800, 0xD800, 0x8800, // 'W'
+    0x8800, 0x8800, 0x5000, 0x2000, 0x5000, 0x8800, 0x8800, // 'X'
+    0x8800, 0x8800, 0x8800, 0x5000, 0x2000, 0x2000, 0x2000, // 'Y'
+    0xF800, 0x0800, 0x1000, 0x2000, 0x4000, 0x8000, 0xF800, // 'Z'
+    0xE000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0xE000, // '['
+    0x0000, 0x8000, 0x4000, 0x2000, 0x1000, 0x0800, 0x0000, // '\\'
+    0xE000, 0x2000, 0x2000, 0x2000, 0x2000, 0x2000, 0xE000, // ']'
+    0x2000, 0x5000, 0x8800, 0x0000, 0x0000, 0x0000, 0x0000, // '^'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xF800, // '_'
+    0x8000, 0x4000, 0x2000, 0x0000, 0x0000, 0x0000, 0x0000, // '`'
+    0x0000, 0x0000, 0x7000, 0x0800, 0x7800, 0x8800, 0x7800, // 'a'
+    0x8000, 0x8000, 0xB000, 0xC800, 0x8800, 0x8800, 0xF000, // 'b'
+    0x0000, 0x0000, 0x7000, 0x8000, 0x8000, 0x8800, 0x7000, // 'c'
+    0x0800, 0x0800, 0x6800, 0x9800, 0x8800, 0x8800, 0x7800, // 'd'
+    0x0000, 0x0000, 0x7000, 0x8800, 0xF800, 0x8000, 0x7000, // 'e'
+    0x3000, 0x4800, 0x4000, 0xE000, 0x4000, 0x4000, 0x4000, // 'f'
+    0x0000, 0x7800, 0x8800, 0x8800, 0x7800, 0x0800, 0x7000, // 'g'
+    0x8000, 0x8000, 0xB000, 0xC800, 0x8800, 0x8800, 0x8800, // 'h'
+    0x4000, 0x0000, 0xC000, 0x4000, 0x4000, 0x4000, 0xE000, // 'i'
+    0x1000, 0x0000, 0x3000, 0x1000, 0x1000, 0x9000, 0x6000, // 'j'
+    0x8000, 0x8000, 0x9000, 0xA000, 0xC000, 0xA000, 0x9000, // 'k'
+    0xC000, 0x4000, 0x4000, 0x4000, 0x4000, 0x4000, 0xE000, // 'l'
+    0x0000, 0x0000, 0xD000, 0xA800, 0xA800, 0x8800, 0x8800, // 'm'
+    0x0000, 0x0000, 0xB000, 0xC800, 0x8800, 0x8800, 0x8800, // 'n'
+    0x0000, 0x0000, 0x7000, 0x8800, 0x8800, 0x8800, 0x7000, // 'o'
+    0x0000, 0x0000, 0xF000, 0x8800, 0xF000, 0x8000, 0x8000, // 'p'
+    0x0000, 0x0000, 0x6800, 0x9800, 0x7800, 0x0800, 0x0800, // 'q'
+    0x0000, 0x0000, 0xB000, 0xC800, 0x8000, 0x8000, 0x8000, // 'r'
+    0x0000, 0x0000, 0x7000, 0x8000, 0x7000, 0x0800, 0xF000, // 's'
+    0x4000, 0x4000, 0xE000, 0x4000, 0x4000, 0x4800, 0x3000, // 't'
+    0x0000, 0x0000, 0x8800, 0x8800, 0x8800, 0x9800, 0x6800, // 'u'
+    0x0000, 0x0000, 0x8800, 0x8800, 0x8800, 0x5000, 0x2000, // 'v'
+    0x0000, 0x0000, 0x8800, 0x8800, 0xA800, 0xA800, 0x5000, // 'w'
+    0x0000, 0x0000, 0x8800, 0x5000, 0x2000, 0x5000, 0x8800, // 'x'
+    0x0000, 0x0000, 0x8800, 0x8800, 0x7800, 0x0800, 0x7000, // 'y'
+    0x0000, 0x0000, 0xF800, 0x1000, 0x2000, 0x4000, 0xF800, // 'z'
+    0x2000, 0x4000, 0x4000, 0x8000, 0x4000, 0x4000, 0x2000, // '{'
+    0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, 0x8000, // '|'
+    0x8000, 0x4000, 0x4000, 0x2000, 0x4000, 0x4000, 0x8000, // '}'
+    0x0000, 0x2000, 0x1000, 0xF800, 0x1000, 0x2000, 0x0000, // '~'
+};
+
+const font_t font_small = {
+    .height = 7,
+    .line_height = 8,
+    .spacing = 1,
+    .first = 32,
+    .count = 95,
+    .widths = font_small_widths,
+    .rows = font_small_rows,
+};
+
+static const uint8_t font_large_widths[95] = {
+    5, 2, 6, 10, 10, 10, 10, 4, 6, 6, 10, 10, 4, 10, 4, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 4, 4, 8, 10, 8, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 6, 10, 10, 10, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 6, 10, 6, 10, 10,
+    6, 10, 10, 10, 10, 10, 10, 10, 10, 6, 8, 8, 6, 10, 10, 10,
+    10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 10, 6, 2, 6, 10,
+};
+
+static const uint16_t font_large_rows[95 * 14] = {
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // ' '
+    0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0x0000, 0x0000, 0xC000, 0xC000, // '!'
+    0xCC00, 0xCC00, 0xCC00, 0xCC00, 0xCC00, 0xCC00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // '"'
+    0x3300, 0x3300, 0x3300, 0x7380, 0xFFC0, 0xFFC0, 0x3300, 0x3300, 0xFFC0, 0xFFC0, 0x7380, 0x3300, 0x3300, 0x3300, // '#'
+    0x0C00, 0x1E00, 0x3FC0, 0x7FC0, 0xCC00, 0xCC00, 0x7F00, 0x3F80, 0x0CC0, 0x0CC0, 0xFF80, 0xFF00, 0x1E00, 0x0C00, // '$'
+    0x6000, 0xF000, 0xF0C0, 0x61C0, 0x0380, 0x0700, 0x0E00, 0x1C00, 0x3800, 0x7000, 0xE180, 0xC3C0, 0x03C0, 0x0180, // '%'
+    0x3C00, 0x7E00, 0xE300, 0xC300, 0xCE00, 0xCC00, 0x3000, 0x3000, 0xCCC0, 0xCCC0, 0xC300, 0xE300, 0x7CC0, 0x3CC0, // '&'
+    0xE000, 0xF000, 0x3000, 0x3000, 0xE000, 0xC000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // '''
+    0x0C00, 0x1C00, 0x3800, 0x7000, 0xE000, 0xC000, 0xC000, 0xC000, 0xC000, 0xE000, 0x7000, 0x3800, 0x1C00, 0x0C00, // '('
+    0xC000, 0xE000, 0x7000, 0x3800, 0x1C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x1C00, 0x3800, 0x7000, 0xE000, 0xC000, // ')'
+    0x0000, 0x0000, 0x0C00, 0x0C00, 0xCCC0, 0xCCC0, 0x3F00, 0x3F00, 0xCCC0, 0xCCC0, 0x0C00, 0x0C00, 0x0000, 0x0000, // '*'
+    0x0000, 0x0000, 0x0C00, 0x0C00, 0x0C00, 0x1E00, 0xFFC0, 0xFFC0, 0x1E00, 0x0C00, 0x0C00, 0x0C00, 0x0000, 0x0000, // '+'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xE000, 0xF000, 0x3000, 0x3000, 0xE000, 0xC000, // ','
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFFC0, 0xFFC0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // '-'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x6000, 0xF000, 0xF000, 0x6000, // '.'
+    0x0000, 0x0000, 0x00C0, 0x01C0, 0x0380, 0x0700, 0x0E00, 0x1C00, 0x3800, 0x7000, 0xE000, 0xC000, 0x0000, 0x0000, // '/'
+    0x3F00, 0x7F80, 0xE0C0, 0xC0C0, 0xC3C0, 0xC7C0, 0xCCC0, 0xCCC0, 0xF8C0, 0xF0C0, 0xC0C0, 0xC1C0, 0x7F80, 0x3F00, // '0'
+    0x0C00, 0x1C00, 0x3C00, 0x3C00, 0x1C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x1E00, 0x3F00, 0x3F00, // '1'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0x00C0, 0x01C0, 0x0380, 0x0700, 0x0E00, 0x1C00, 0x3000, 0x7000, 0xFFC0, 0xFFC0, // '2'
+    0xFFC0, 0xFFC0, 0x0380, 0x0300, 0x0C00, 0x0C00, 0x0700, 0x0380, 0x01C0, 0x00C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // '3'
+    0x0300, 0x0700, 0x0F00, 0x1F00, 0x3300, 0x7300, 0xC300, 0xC780, 0xFFC0, 0x7FC0, 0x0780, 0x0300, 0x0300, 0x0300, // '4'
+    0x7FC0, 0xFFC0, 0xC000, 0xC000, 0xFF00, 0x7F80, 0x01C0, 0x00C0, 0x00C0, 0x00C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // '5'
+    0x0F00, 0x1F00, 0x3800, 0x7000, 0xC000, 0xC000, 0xFF00, 0xFF80, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // '6'
+    0xFF80, 0xFFC0, 0x00C0, 0x00C0, 0x0380, 0x0700, 0x0E00, 0x1C00, 0x3800, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, // '7'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x3F00, 0x3F00, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // '8'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7FC0, 0x3FC0, 0x00C0, 0x00C0, 0x0380, 0x0700, 0x3E00, 0x3C00, // '9'
+    0x0000, 0x0000, 0x6000, 0xF000, 0xF000, 0x6000, 0x0000, 0x0000, 0x6000, 0xF000, 0xF000, 0x6000, 0x0000, 0x0000, // ':'
+    0x0000, 0x0000, 0x6000, 0xF000, 0xF000, 0x6000, 0x0000, 0x0000, 0xE000, 0xF000, 0x3000, 0x3000, 0xE000, 0xC000, // ';'
+    0x0300, 0x0700, 0x0E00, 0x1C00, 0x3800, 0x7000, 0xC000, 0xC000, 0x7000, 0x3800, 0x1C00, 0x0E00, 0x0700, 0x0300, // '<'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xFFC0, 0xFFC0, 0x0000, 0x0000, 0xFFC0, 0xFFC0, 0x0000, 0x0000, 0x0000, 0x0000, // '='
+    0xC000, 0xE000, 0x7000, 0x3800, 0x1C00, 0x0E00, 0x0300, 0x0300, 0x0E00, 0x1C00, 0x3800, 0x7000, 0xE000, 0xC000, // '>'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0x00C0, 0x01C0, 0x0380, 0x0700, 0x0E00, 0x0C00, 0x0000, 0x0000, 0x0C00, 0x0C00, // '?'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0x00C0, 0x00C0, 0x38C0, 0x7CC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0x7F80, 0x3F00, // '@'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFFC0, 0xFFC0, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'A'
+    0x7F00, 0xFF80, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFF00, 0xFF00, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFF80, 0x7F00, // 'B'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // 'C'
+    0x7C00, 0xFE00, 0xE700, 0xC380, 0xC1C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC1C0, 0xC380, 0xE700, 0xFE00, 0x7C00, // 'D'
+    0x7FC0, 0xFFC0, 0xE000, 0xC000, 0xC000, 0xE000, 0xFF00, 0xFF00, 0xE000, 0xC000, 0xC000, 0xE000, 0xFFC0, 0x7FC0, // 'E'
+    0x7FC0, 0xFFC0, 0xE000, 0xC000, 0xC000, 0xE000, 0xFF00, 0xFF00, 0xE000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, // 'F'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC000, 0xC000, 0xCF80, 0xCFC0, 0xC1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7FC0, 0x3F80, // 'G'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFFC0, 0xFFC0, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'H'
+    0xFC00, 0xFC00, 0x7800, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x7800, 0xFC00, 0xFC00, // 'I'
+    0x0FC0, 0x0FC0, 0x0780, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0x0300, 0xC300, 0xE700, 0x7E00, 0x3C00, // 'J'
+    0xC0C0, 0xC1C0, 0xC380, 0xC700, 0xCE00, 0xCC00, 0xF000, 0xF000, 0xCC00, 0xCE00, 0xC700, 0xC380, 0xC1C0, 0xC0C0, // 'K'
+    0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xE000, 0xFFC0, 0x7FC0, // 'L'
+    0xC0C0, 0xE1C0, 0xF3C0, 0xF3C0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'M'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xE0C0, 0xF0C0, 0xF8C0, 0xCCC0, 0xCCC0, 0xC7C0, 0xC3C0, 0xC1C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'N'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // 'O'
+    0x7F00, 0xFF80, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFF80, 0xFF00, 0xE000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, // 'P'
+    0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xCCC0, 0xCCC0, 0xC300, 0xE300, 0x7CC0, 0x3CC0, // 'Q'
+    0x7F00, 0xFF80, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFF80, 0xFF00, 0xCC00, 0xCC00, 0xC700, 0xC380, 0xC1C0, 0xC0C0, // 'R'
+    0x3FC0, 0x7FC0, 0xE000, 0xC000, 0xC000, 0xE000, 0x7F00, 0x3F80, 0x01C0, 0x00C0, 0x00C0, 0x01C0, 0xFF80, 0xFF00, // 'S'
+    0xFFC0, 0xFFC0, 0x1E00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, // 'T'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // 'U'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7380, 0x3300, 0x1E00, 0x0C00, // 'V'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xF3C0, 0xF3C0, 0xE1C0, 0xC0C0, // 'W'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7380, 0x3300, 0x0C00, 0x0C00, 0x3300, 0x7380, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'X'
+    0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7380, 0x3300, 0x1E00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, // 'Y'
+    0xFF80, 0xFFC0, 0x00C0, 0x00C0, 0x0380, 0x0700, 0x0E00, 0x1C00, 0x3800, 0x7000, 0xC000, 0xC000, 0xFFC0, 0x7FC0, // 'Z'
+    0x7C00, 0xFC00, 0xE000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xE000, 0xFC00, 0x7C00, // '['
+    0x0000, 0x0000, 0xC000, 0xE000, 0x7000, 0x3800, 0x1C00, 0x0E00, 0x0700, 0x0380, 0x01C0, 0x00C0, 0x0000, 0x0000, // '\\'
+    0xF800, 0xFC00, 0x1C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x0C00, 0x1C00, 0xFC00, 0xF800, // ']'
+    0x0C00, 0x1E00, 0x3300, 0x7380, 0xE1C0, 0xC0C0, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // '^'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0xFFC0, 0xFFC0, // '_'
+    0xC000, 0xE000, 0x7000, 0x3800, 0x1C00, 0x0C00, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, 0x0000, // '`'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x3F00, 0x3F80, 0x00C0, 0x00C0, 0x3FC0, 0x7FC0, 0xC0C0, 0xC0C0, 0x7FC0, 0x3F80, // 'a'
+    0xC000, 0xC000, 0xC000, 0xC000, 0xCF00, 0xCF80, 0xF9C0, 0xF0C0, 0xE0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0xFF80, 0x7F00, // 'b'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x3F00, 0x7F00, 0xE000, 0xC000, 0xC000, 0xC000, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // 'c'
+    0x00C0, 0x00C0, 0x00C0, 0x00C0, 0x3CC0, 0x7CC0, 0xE7C0, 0xC3C0, 0xC1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7FC0, 0x3F80, // 'd'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x3F00, 0x7F80, 0xC0C0, 0xC0C0, 0xFFC0, 0xFF80, 0xC000, 0xC000, 0x7F00, 0x3F00, // 'e'
+    0x0F00, 0x1F80, 0x39C0, 0x30C0, 0x3000, 0x7800, 0xFC00, 0xFC00, 0x7800, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, // 'f'
+    0x0000, 0x0000, 0x3F80, 0x7FC0, 0xE1C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7FC0, 0x3FC0, 0x00C0, 0x00C0, 0x3F80, 0x3F00, // 'g'
+    0xC000, 0xC000, 0xC000, 0xC000, 0xCF00, 0xCF80, 0xF9C0, 0xF0C0, 0xE0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'h'
+    0x3000, 0x3000, 0x0000, 0x0000, 0xE000, 0xF000, 0x7000, 0x3000, 0x3000, 0x3000, 0x3000, 0x7800, 0xFC00, 0xFC00, // 'i'
+    0x0300, 0x0300, 0x0000, 0x0000, 0x0E00, 0x0F00, 0x0700, 0x0300, 0x0300, 0x0300, 0xC300, 0xE700, 0x7E00, 0x3C00, // 'j'
+    0xC000, 0xC000, 0xC000, 0xC000, 0xC300, 0xC700, 0xCE00, 0xCC00, 0xF000, 0xF000, 0xCC00, 0xCE00, 0xC700, 0xC300, // 'k'
+    0xE000, 0xF000, 0x7000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x3000, 0x7800, 0xFC00, 0xFC00, // 'l'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x7300, 0xF380, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'm'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xCF00, 0xCF80, 0xF9C0, 0xF0C0, 0xE0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, // 'n'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x3F00, 0x7F80, 0xE1C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7F80, 0x3F00, // 'o'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x7F00, 0xFF80, 0xC0C0, 0xC0C0, 0xFF80, 0xFF00, 0xE000, 0xC000, 0xC000, 0xC000, // 'p'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x3CC0, 0x7CC0, 0xC1C0, 0xC3C0, 0x7FC0, 0x3FC0, 0x01C0, 0x00C0, 0x00C0, 0x00C0, // 'q'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xCF00, 0xCF80, 0xF9C0, 0xF0C0, 0xE000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, // 'r'
+    0x0000, 0x0000, 0x0000, 0x0000, 0x3F00, 0x7F00, 0xC000, 0xC000, 0x7F00, 0x3F80, 0x00C0, 0x00C0, 0xFF80, 0xFF00, // 's'
+    0x3000, 0x3000, 0x3000, 0x7800, 0xFC00, 0xFC00, 0x7800, 0x3000, 0x3000, 0x3000, 0x30C0, 0x39C0, 0x1F80, 0x0F00, // 't'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC1C0, 0xC3C0, 0xE7C0, 0x7CC0, 0x3CC0, // 'u'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7380, 0x3300, 0x1E00, 0x0C00, // 'v'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC0C0, 0xC0C0, 0xC0C0, 0xC0C0, 0xCCC0, 0xCCC0, 0xCCC0, 0xCCC0, 0x7380, 0x3300, // 'w'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC0C0, 0xE1C0, 0x7380, 0x3300, 0x0C00, 0x0C00, 0x3300, 0x7380, 0xE1C0, 0xC0C0, // 'x'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xC0C0, 0xC0C0, 0xC0C0, 0xE1C0, 0x7FC0, 0x3FC0, 0x00C0, 0x00C0, 0x3F80, 0x3F00, // 'y'
+    0x0000, 0x0000, 0x0000, 0x0000, 0xFFC0, 0xFFC0, 0x0380, 0x0300, 0x0E00, 0x1C00, 0x3000, 0x7000, 0xFFC0, 0xFFC0, // 'z'
+    0x0C00, 0x1C00, 0x3800, 0x3000, 0x3000, 0x7000, 0xC000, 0xC000, 0x7000, 0x3000, 0x3000, 0x3800, 0x1C00, 0x0C00, // '{'
+    0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, 0xC000, // '|'
+    0xC000, 0xE000, 0x7000, 0x3000, 0x3000, 0x3800, 0x0C00, 0x0C00, 0x3800, 0x3000, 0x3000, 0x7000, 0xE000, 0xC000, // '}'
+    0x0000, 0x0000, 0x0C00, 0x0E00, 0x0300, 0x0380, 0xFFC0, 0xFFC0, 0x0380, 0x0300, 0x0E00, 0x0C00, 0x0000, 0x0000, // '~'
+};
+
+const font_t font_large = {
+    .height = 14,
+    .line_height = 16,
+    .spacing = 2,
+    .first = 32,
+    .count = 95,
+    .widths = font_large_widths,
+    .rows = font_large_rows,
+};
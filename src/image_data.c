@@ -0,0 +1,84 @@
+// Generated by tools/imggen/imggen.py from tools/imggen/icons. Do not edit.
+
+#include <stdint.h>
+
+#include "image.h"
+
+static const uint16_t icon_camera_palette[5] = {
+    0xFFFF, 0xFF07, 0xEF00, 0x00F8, 0x0000,
+};
+
+static const uint8_t icon_camera_data[38] = {
+    0xE4, 0x20, 0x44, 0x80, 0x14, 0x10, 0x04, 0x21, 0x04, 0x03, 0x00, 0x14,
+    0x10, 0x11, 0x02, 0x11, 0x10, 0x14, 0x10, 0x01, 0x22, 0x01, 0x10, 0x14,
+    0x10, 0x11, 0x02, 0x11, 0x10, 0x14, 0x10, 0x04, 0x21, 0x04, 0x10, 0x14,
+    0x80, 0x04,
+};
+
+const image_t icon_camera = {
+    .w = 11,
+    .h = 9,
+    .colors = 5,
+    .transparent = 4,
+    .runs = 38,
+    .palette = icon_camera_palette,
+    .data = icon_camera_data,
+};
+
+static const uint16_t icon_rail_palette[4] = {
+    0x00FF, 0xFF07, 0xFFFF, 0x0000,
+};
+
+static const uint8_t icon_rail_data[20] = {
+    0x33, 0x21, 0x53, 0x60, 0x33, 0x00, 0x43, 0x00, 0x33, 0x60, 0x13, 0x02,
+    0x33, 0x00, 0x33, 0xC2, 0x83, 0xC2, 0x83, 0x02,
+};
+
+const image_t icon_rail = {
+    .w = 11,
+    .h = 9,
+    .colors = 4,
+    .transparent = 3,
+    .runs = 20,
+    .palette = icon_rail_palette,
+    .data = icon_rail_data,
+};
+
+static const uint16_t icon_settings_palette[2] = {
+    0xFFFF, 0x0000,
+};
+
+static const uint8_t icon_settings_data[37] = {
+    0x31, 0x00, 0x01, 0x00, 0x51, 0x00, 0x01, 0x20, 0x01, 0x00, 0x41, 0x40,
+    0x31, 0x20, 0x21, 0x20, 0x21, 0x10, 0x21, 0x10, 0x21, 0x20, 0x21, 0x20,
+    0x31, 0x40, 0x41, 0x00, 0x01, 0x20, 0x01, 0x00, 0x51, 0x00, 0x01, 0x00,
+    0x31,
+};
+
+const image_t icon_settings = {
+    .w = 11,
+    .h = 9,
+    .colors = 2,
+    .transparent = 1,
+    .runs = 37,
+    .palette = icon_settings_palette,
+    .data = icon_settings_data,
+};
+
+static const uint16_t icon_stack_palette[5] = {
+    0x00FF, 0xE007, 0xFF07, 0xFFFF, 0x0000,
+};
+
+static const uint8_t icon_stack_data[9] = {
+    0xB4, 0x80, 0xC4, 0x81, 0xC4, 0x82, 0xC4, 0x83, 0xB4,
+};
+
+const image_t icon_stack = {
+    .w = 11,
+    .h = 9,
+    .colors = 5,
+    .transparent = 4,
+    .runs = 9,
+    .palette = icon_stack_palette,
+    .data = icon_stack_data,
+};
@@ -1,44 +1,80 @@
+#include <stdbool.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 #include "esp_timer.h"
 
 #include "encoder.h"
 #include "display.h"
 #include "stepper.h"
+#include "motion_trace.h"
+#include "stack.h"
 #include "menu.h"
+#include "console.h"
+#include "render.h"
+#include "boot_prof.h"
 
 static const char *TAG = "FOCUS_RAIL";
 
+static SemaphoreHandle_t display_ready = NULL;
+static volatile bool other_init_done = false;
+
+// The panel spends most of its bring-up waiting for reset and sleep-out, so it
+// comes up on its own task while app_main initialises everything else. The
+// splash is only drawn if that other work is still going on.
+static void display_init_task(void *pvParameters) {
+    display_init();
+    boot_prof_mark("display init");
+
+    if (!other_init_done) {
+        display_welcome();
+        display_flush_dirty();
+        boot_prof_mark("splash");
+    }
+
+    xSemaphoreGive(display_ready);
+    vTaskDelete(NULL);
+}
+
 void app_main(void) {
+    boot_prof_mark("app_main");
     ESP_LOGI(TAG, "Starting Focus Rail Controller");
     
-    // Initialize components
+    display_ready = xSemaphoreCreateBinary();
+    xTaskCreate(display_init_task, "display_init", 4096, NULL, 5, NULL);
+    
+    // Initialize the other components meanwhile
     encoder_init();
-    display_init();
+    boot_prof_mark("encoder init");
     stepper_init();
+    motion_trace_init();
+    stack_init();
+    boot_prof_mark("stepper init");
     menu_init();
+    menu_set_stepper_callbacks(stepper_move, stepper_enable);
+    console_init();
+    boot_prof_mark("menu init");
     
-    ESP_LOGI(TAG, "Hardware initialized");
-    
-    // Create tasks
+    // Input is taken from here on; the menu state is drawn once rendering starts
     xTaskCreate(encoder_task, "encoder_task", 4096, NULL, 10, NULL);
     xTaskCreate(menu_task, "menu_task", 4096, NULL, 5, NULL);
+    xTaskCreate(console_task, "console_task", 4096, NULL, 2, NULL);
+    other_init_done = true;
+    boot_prof_mark("tasks started");
     
-    ESP_LOGI(TAG, "Tasks created, system ready");
-    
-    // Display welcome message
-    display_welcome();
-    display_flush_dirty();  
-
-    vTaskDelay(pdMS_TO_TICKS(2000));
+    // From here on the render task owns the display
+    xSemaphoreTake(display_ready, portMAX_DELAY);
+    render_start(menu_display);
+    boot_prof_mark("ready");
     
-    menu_display();
+    ESP_LOGI(TAG, "System ready in %lld ms", (long long)esp_timer_get_time() / 1000);
+    boot_prof_print_report();
     
     while (1) {
         vTaskDelay(pdMS_TO_TICKS(1000));
     }
-}
\ No newline at end of file
+}
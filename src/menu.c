@@ -3,10 +3,15 @@
 #include <stdlib.h>
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
+#include "freertos/semphr.h"
 #include "esp_log.h"
 
 #include "menu.h"
 #include "display.h"  // Assuming you'll create a display module
+#include "render.h"
+#include "menu_view.h"
+#include "motion_trace.h"
+#include "stack.h"
 
 static const char *TAG = "MENU";
 
@@ -16,24 +21,31 @@ static menu_config_t menu_config = {
     .step_size = 1,
     .motor_enabled = false,
     .current_menu = MENU_MAIN,
-    .menu_selection = 0
+    .menu_selection = 0,
+    .stack_shots = 50
 };
 
 // Callback functions for hardware control
 static stepper_move_callback_t stepper_move_cb = NULL;
 static stepper_enable_callback_t stepper_enable_cb = NULL;
 
+// Guards menu_config between the encoder task (input) and the render task
+static SemaphoreHandle_t menu_mutex = NULL;
+
+// Steps requested by the move menu, issued once the mutex is released
+static int pending_steps = 0;
+
 // Private function prototypes
 static void handle_main_menu_input(encoder_event_t *event);
 static void handle_move_menu_input(encoder_event_t *event);
 static void handle_settings_menu_input(encoder_event_t *event);
 static void handle_auto_stack_menu_input(encoder_event_t *event);
-static void display_main_menu(void);
-static void display_move_menu(void);
-static void display_settings_menu(void);
-static void display_auto_stack_menu(void);
+static void handle_stack_progress_input(encoder_event_t *event);
+static void move_selection(int detents, int entries);
 
 void menu_init(void) {
+    menu_mutex = xSemaphoreCreateMutex();
+    menu_config.trace = motion_trace_ring();
     ESP_LOGI(TAG, "Menu system initialized");
 }
 
@@ -45,6 +57,7 @@ void menu_set_stepper_callbacks(stepper_move_callback_t move_cb, stepper_enable_
 void menu_handle_input(encoder_event_t *event) {
     if (event == NULL) return;
     
+    xSemaphoreTake(menu_mutex, portMAX_DELAY);
     switch (menu_config.current_menu) {
         case MENU_MAIN:
             handle_main_menu_input(event);
@@ -58,24 +71,43 @@ void menu_handle_input(encoder_event_t *event) {
         case MENU_AUTO_STACK:
             handle_auto_stack_menu_input(event);
             break;
+        case MENU_STACK_PROGRESS:
+            handle_stack_progress_input(event);
+            break;
     }
+    int steps = pending_steps;
+    pending_steps = 0;
+    xSemaphoreGive(menu_mutex);
+    
+    // Moves can take a while, keep the menu unlocked meanwhile
+    if (steps != 0 && stepper_move_cb) {
+        stepper_move_cb(steps);
+    }
+    render_invalidate();
 }
 
+// Draws the current menu into the framebuffer. Only the render task calls
+// this; everyone else uses render_invalidate().
 void menu_display(void) {
-    switch (menu_config.current_menu) {
-        case MENU_MAIN:
-            display_main_menu();
-            break;
-        case MENU_MOVE:
-            display_move_menu();
-            break;
-        case MENU_SETTINGS:
-            display_settings_menu();
-            break;
-        case MENU_AUTO_STACK:
-            display_auto_stack_menu();
-            break;
+    menu_config_t cfg;
+    stack_progress_t progress;
+    
+    xSemaphoreTake(menu_mutex, portMAX_DELAY);
+    cfg = menu_config;
+    xSemaphoreGive(menu_mutex);
+    
+    if (cfg.current_menu == MENU_STACK_PROGRESS) {
+        stack_get_progress(&progress);
+        cfg.stack = &progress;
     }
+    
+    menu_view_draw(&cfg);
+}
+
+// Lists move one entry per detent, without acceleration, wrapping around
+static void move_selection(int detents, int entries) {
+    int selection = (menu_config.menu_selection + detents) % entries;
+    menu_config.menu_selection = selection < 0 ? selection + entries : selection;
 }
 
 // Main menu input handling
@@ -91,17 +123,14 @@ static void handle_main_menu_input(encoder_event_t *event) {
                 break;
             case 2: // Auto Stack
                 menu_config.current_menu = MENU_AUTO_STACK;
+                menu_config.menu_selection = 0;
                 break;
         }
-        menu_display();
         return;
     }
     
-    if (event->direction != 0) {
-        menu_config.menu_selection += event->direction;
-        if (menu_config.menu_selection < 0) menu_config.menu_selection = 2;
-        if (menu_config.menu_selection > 2) menu_config.menu_selection = 0;
-        menu_display();
+    if (event->detents != 0) {
+        move_selection(event->detents, 3);
     }
 }
 
@@ -110,17 +139,16 @@ static void handle_move_menu_input(encoder_event_t *event) {
     if (event->button_pressed) {
         menu_config.current_menu = MENU_MAIN;
         menu_config.menu_selection = 0;
-        menu_display();
         return;
     }
     
-    if (event->direction != 0) {
+    // The accelerated delta: fast spins cover distance, slow turns stay exact
+    if (event->delta != 0) {
         if (menu_config.motor_enabled && stepper_move_cb) {
-            int steps = event->direction * menu_config.step_size;
-            stepper_move_cb(steps);
+            int steps = event->delta * menu_config.step_size;
+            pending_steps = steps;
             menu_config.focus_position += steps;
         }
-        menu_display();
     }
 }
 
@@ -150,133 +178,75 @@ static void handle_settings_menu_input(encoder_event_t *event) {
                 menu_config.menu_selection = 0;
                 break;
         }
-        menu_display();
         return;
     }
     
-    if (event->direction != 0) {
-        menu_config.menu_selection += event->direction;
-        if (menu_config.menu_selection < 0) menu_config.menu_selection = 3;
-        if (menu_config.menu_selection > 3) menu_config.menu_selection = 0;
-        menu_display();
+    if (event->detents != 0) {
+        move_selection(event->detents, 4);
     }
 }
 
 // Auto stack menu input handling
 static void handle_auto_stack_menu_input(encoder_event_t *event) {
     if (event->button_pressed) {
-        menu_config.current_menu = MENU_MAIN;
-        menu_config.menu_selection = 0;
-        menu_display();
+        switch (menu_config.menu_selection) {
+            case 0: // Shots
+                // Cycle through stack sizes: 10, 25, 50, 100, 200
+                if (menu_config.stack_shots == 10) menu_config.stack_shots = 25;
+                else if (menu_config.stack_shots == 25) menu_config.stack_shots = 50;
+                else if (menu_config.stack_shots == 50) menu_config.stack_shots = 100;
+                else if (menu_config.stack_shots == 100) menu_config.stack_shots = 200;
+                else menu_config.stack_shots = 10;
+                break;
+            case 1: // Start
+                if (stack_start(menu_config.stack_shots, menu_config.step_size)) {
+                    menu_config.current_menu = MENU_STACK_PROGRESS;
+                }
+                break;
+            case 2: // Back
+                menu_config.current_menu = MENU_MAIN;
+                menu_config.menu_selection = 0;
+                break;
+        }
+        return;
     }
-    // No encoder movement handling in auto stack menu for now
-}
-
-// Main menu display
-static void display_main_menu(void) {
-    display_fill_screen(BLACK);      
-    
-    display_print_string(10, 10, "FOCUS RAIL", WHITE, TRANSPARENT, 2);
-    display_print_string(10, 30, "----------", WHITE, TRANSPARENT, 1);
-    
-    display_print_string(10, 45, menu_config.menu_selection == 0 ? ">Move" : " Move", 
-                       menu_config.menu_selection == 0 ? YELLOW : WHITE, TRANSPARENT, 1);
-    display_print_string(10, 55, menu_config.menu_selection == 1 ? ">Settings" : " Settings", 
-                       menu_config.menu_selection == 1 ? YELLOW : WHITE, TRANSPARENT, 1);
-    display_print_string(10, 65, menu_config.menu_selection == 2 ? ">Auto Stack" : " Auto Stack", 
-                       menu_config.menu_selection == 2 ? YELLOW : WHITE, TRANSPARENT, 1);
-    
-    char buffer[32];
-    sprintf(buffer, "Pos: %d", menu_config.focus_position);
-    display_print_string(10, 85, buffer, GREEN, TRANSPARENT, 1);
-    
-    sprintf(buffer, "Step: %d", menu_config.step_size);
-    display_print_string(10, 95, buffer, GREEN, TRANSPARENT, 1);
-    
-    display_print_string(10, 105, menu_config.motor_enabled ? "Motor: ON" : "Motor: OFF", 
-                       menu_config.motor_enabled ? GREEN : RED, TRANSPARENT, 1);
-
-                       display_flush_dirty();  
-}
-
-// Move menu display
-static void display_move_menu(void) {
-    display_fill_screen(BLACK);
-    
-    display_print_string(10, 10, "MOVE MODE", WHITE, TRANSPARENT, 2);
-    display_print_string(10, 30, "---------", WHITE, TRANSPARENT, 1);
     
-    char buffer[32];
-    sprintf(buffer, "Position: %d", menu_config.focus_position);
-    display_print_string(10, 45, buffer, WHITE, TRANSPARENT, 1);
-    
-    sprintf(buffer, "Step Size: %d", menu_config.step_size);
-    display_print_string(10, 55, buffer, WHITE, TRANSPARENT, 1);
-    
-    display_print_string(10, 70, "Rotate: Move", YELLOW, TRANSPARENT, 1);
-    display_print_string(10, 80, "Press: Menu", YELLOW, TRANSPARENT, 1);
-    
-    if (menu_config.motor_enabled) {
-        display_print_string(10, 100, "Motor: ENABLED", GREEN, TRANSPARENT, 1);
-    } else {
-        display_print_string(10, 100, "Motor: DISABLED", RED, TRANSPARENT, 1);
-        display_print_string(10, 110, "Enable in Settings", RED, TRANSPARENT, 1);
+    if (event->detents != 0) {
+        move_selection(event->detents, 3);
     }
-display_flush_dirty();  
-}
-
-// Settings menu display
-static void display_settings_menu(void) {
-    display_fill_screen(BLACK);
-    
-    display_print_string(10, 10, "SETTINGS", WHITE, TRANSPARENT, 2);
-    display_print_string(10, 30, "--------", WHITE, TRANSPARENT, 1);
-    
-    display_print_string(10, 45, menu_config.menu_selection == 0 ? ">Step Size" : " Step Size", 
-                       menu_config.menu_selection == 0 ? YELLOW : WHITE, TRANSPARENT, 1);
-    char buffer[32];
-    sprintf(buffer, "  Current: %d", menu_config.step_size);
-    display_print_string(10, 55, buffer, WHITE, TRANSPARENT, 1);
-    
-    display_print_string(10, 70, menu_config.menu_selection == 1 ? ">Motor Enable" : " Motor Enable", 
-                       menu_config.menu_selection == 1 ? YELLOW : WHITE, TRANSPARENT, 1);
-    sprintf(buffer, "  Status: %s", menu_config.motor_enabled ? "ON" : "OFF");
-    display_print_string(10, 80, buffer, menu_config.motor_enabled ? GREEN : RED, TRANSPARENT, 1);
-    
-    display_print_string(10, 95, menu_config.menu_selection == 2 ? ">Reset Position" : " Reset Position", 
-                       menu_config.menu_selection == 2 ? YELLOW : WHITE, TRANSPARENT, 1);
-    
-    display_print_string(10, 110, menu_config.menu_selection == 3 ? ">Back" : " Back", 
-                       menu_config.menu_selection == 3 ? YELLOW : WHITE, TRANSPARENT, 1);
-display_flush_dirty();  
 }
 
-// Auto stack menu display
-static void display_auto_stack_menu(void) {
-    display_fill_screen(BLACK);
+// Stack progress input handling: press stops a running stack, then returns
+static void handle_stack_progress_input(encoder_event_t *event) {
+    stack_progress_t progress;
     
-    display_print_string(10, 10, "AUTO STACK", WHITE, TRANSPARENT, 2);
-    display_print_string(10, 30, "----------", WHITE, TRANSPARENT, 1);
+    if (!event->button_pressed) return;
     
-    display_print_string(10, 45, "Coming Soon!", YELLOW, TRANSPARENT, 1);
-    display_print_string(10, 60, "- Set start/end", WHITE, TRANSPARENT, 1);
-    display_print_string(10, 70, "- Set intervals", WHITE, TRANSPARENT, 1);
-    display_print_string(10, 80, "- Auto capture", WHITE, TRANSPARENT, 1);
+    stack_get_progress(&progress);
+    if (progress.running) {
+        stack_stop();
+        return;
+    }
     
-    display_print_string(10, 100, "Press to return", YELLOW, TRANSPARENT, 1);
-display_flush_dirty();  
+    // The stack moved the rail on its own
+    if (progress.shots_done > 1) {
+        menu_config.focus_position += (progress.shots_done - 1) * progress.step;
+    }
+    menu_config.current_menu = MENU_AUTO_STACK;
+    menu_config.menu_selection = 0;
 }
 
 // Menu task
 void menu_task(void *pvParameters) {
-    menu_display();
-    
     while (1) {
-        // Update display every 100ms if in move mode to show real-time position
-        if (menu_config.current_menu == MENU_MOVE) {
-            menu_display();
+        // Refresh the position readout at the frame rate in move mode, and
+        // the ETA countdown during a stack. Only digits that changed are
+        // redrawn, so an unchanged readout costs nothing.
+        if (menu_config.current_menu == MENU_MOVE ||
+            menu_config.current_menu == MENU_STACK_PROGRESS) {
+            render_invalidate();
         }
-        vTaskDelay(pdMS_TO_TICKS(100));
+        vTaskDelay(pdMS_TO_TICKS(1000 / RENDER_FPS));
     }
 }
 
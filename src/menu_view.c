@@ -0,0 +1,367 @@
+#include <string.h>
+
+#include "menu_view.h"
+#include "display.h"
+#include "widget.h"
+#include "plot_view.h"
+#include "scroll_view.h"
+#include "stack.h"
+#include "numfmt.h"
+
+// Each menu is a retained widget screen. menu_view_draw() pushes the menu
+// state into the widgets and only what changed is redrawn; switching menus
+// redraws the new screen completely.
+
+// Main menu
+enum {
+    MAIN_HEADER, MAIN_RULE,
+    MAIN_MARK_MOVE, MAIN_MOVE,
+    MAIN_MARK_SETTINGS, MAIN_SETTINGS,
+    MAIN_MARK_STACK, MAIN_STACK,
+    MAIN_POS, MAIN_STEP, MAIN_MOTOR,
+    MAIN_ICON_MOVE, MAIN_ICON_SETTINGS, MAIN_ICON_STACK
+};
+
+static widget_t main_items[] = {
+    [MAIN_HEADER]        = WIDGET_LABEL_INIT(10, 10, "FOCUS RAIL", &font_large, WHITE),
+    [MAIN_RULE]          = WIDGET_LABEL_INIT(10, 30, "----------", NULL, WHITE),
+    [MAIN_MARK_MOVE]     = WIDGET_MARKER_INIT(10, 45, ">", YELLOW),
+    [MAIN_MOVE]          = WIDGET_LABEL_INIT(16, 45, "Move", NULL, WHITE),
+    [MAIN_MARK_SETTINGS] = WIDGET_MARKER_INIT(10, 55, ">", YELLOW),
+    [MAIN_SETTINGS]      = WIDGET_LABEL_INIT(16, 55, "Settings", NULL, WHITE),
+    [MAIN_MARK_STACK]    = WIDGET_MARKER_INIT(10, 65, ">", YELLOW),
+    [MAIN_STACK]         = WIDGET_LABEL_INIT(16, 65, "Auto Stack", NULL, WHITE),
+    [MAIN_POS]           = WIDGET_VALUE_INIT(10, 85, "Pos: ", GREEN),
+    [MAIN_STEP]          = WIDGET_VALUE_INIT(10, 95, "Step: ", GREEN),
+    [MAIN_MOTOR]         = WIDGET_LABEL_INIT(10, 105, "Motor: OFF", NULL, RED),
+    [MAIN_ICON_MOVE]     = WIDGET_IMAGE_INIT(108, 44, &icon_rail),
+    [MAIN_ICON_SETTINGS] = WIDGET_IMAGE_INIT(108, 54, &icon_settings),
+    [MAIN_ICON_STACK]    = WIDGET_IMAGE_INIT(108, 64, &icon_stack),
+};
+
+static const uint8_t main_markers[] = { MAIN_MARK_MOVE, MAIN_MARK_SETTINGS, MAIN_MARK_STACK };
+
+static widget_t main_screen = WIDGET_SCREEN_INIT(main_items, BLACK);
+
+// Move menu
+enum {
+    MOVE_HEADER, MOVE_RULE,
+    MOVE_POS, MOVE_STEP,
+    MOVE_HINT_ROTATE, MOVE_HINT_PRESS,
+    MOVE_MOTOR, MOVE_MOTOR_HINT
+};
+
+static widget_t move_items[] = {
+    [MOVE_HEADER]      = WIDGET_LABEL_INIT(10, 10, "MOVE MODE", &font_large, WHITE),
+    [MOVE_RULE]        = WIDGET_LABEL_INIT(10, 30, "---------", NULL, WHITE),
+    [MOVE_POS]         = WIDGET_VALUE_INIT(10, 45, "Position: ", WHITE),
+    [MOVE_STEP]        = WIDGET_VALUE_INIT(10, 55, "Step Size: ", WHITE),
+    [MOVE_HINT_ROTATE] = WIDGET_LABEL_INIT(10, 70, "Rotate: Move", NULL, YELLOW),
+    [MOVE_HINT_PRESS]  = WIDGET_LABEL_INIT(10, 80, "Press: Menu", NULL, YELLOW),
+    [MOVE_MOTOR]       = WIDGET_LABEL_INIT(10, 100, "Motor: DISABLED", NULL, RED),
+    [MOVE_MOTOR_HINT]  = WIDGET_LABEL_INIT(10, 110, "Enable in Settings", NULL, RED),
+};
+
+static widget_t move_screen = WIDGET_SCREEN_INIT(move_items, BLACK);
+
+// Position (autoscaled) and velocity trace under the readout
+#define MOVE_PLOT_POS_SPAN      200     // steps
+#define MOVE_PLOT_SPEED_MAX     300     // steps/s at full scale
+
+static plot_view_t move_plot = PLOT_VIEW_INIT(10, 122, 108, 34, NULL);
+
+// Settings menu
+enum {
+    SET_HEADER, SET_RULE,
+    SET_MARK_STEP, SET_STEP, SET_STEP_VALUE,
+    SET_MARK_MOTOR, SET_MOTOR, SET_MOTOR_STATUS,
+    SET_MARK_RESET, SET_RESET,
+    SET_MARK_BACK, SET_BACK
+};
+
+static widget_t settings_items[] = {
+    [SET_HEADER]       = WIDGET_LABEL_INIT(10, 10, "SETTINGS", &font_large, WHITE),
+    [SET_RULE]         = WIDGET_LABEL_INIT(10, 30, "--------", NULL, WHITE),
+    [SET_MARK_STEP]    = WIDGET_MARKER_INIT(10, 45, ">", YELLOW),
+    [SET_STEP]         = WIDGET_LABEL_INIT(16, 45, "Step Size", NULL, WHITE),
+    [SET_STEP_VALUE]   = WIDGET_VALUE_INIT(10, 55, "  Current: ", WHITE),
+    [SET_MARK_MOTOR]   = WIDGET_MARKER_INIT(10, 70, ">", YELLOW),
+    [SET_MOTOR]        = WIDGET_LABEL_INIT(16, 70, "Motor Enable", NULL, WHITE),
+    [SET_MOTOR_STATUS] = WIDGET_LABEL_INIT(10, 80, "  Status: OFF", NULL, RED),
+    [SET_MARK_RESET]   = WIDGET_MARKER_INIT(10, 95, ">", YELLOW),
+    [SET_RESET]        = WIDGET_LABEL_INIT(16, 95, "Reset Position", NULL, WHITE),
+    [SET_MARK_BACK]    = WIDGET_MARKER_INIT(10, 110, ">", YELLOW),
+    [SET_BACK]         = WIDGET_LABEL_INIT(16, 110, "Back", NULL, WHITE),
+};
+
+static const uint8_t settings_markers[] = { SET_MARK_STEP, SET_MARK_MOTOR, SET_MARK_RESET, SET_MARK_BACK };
+
+static widget_t settings_screen = WIDGET_SCREEN_INIT(settings_items, BLACK);
+
+// Auto stack menu
+enum {
+    AUTO_HEADER, AUTO_RULE,
+    AUTO_MARK_SHOTS, AUTO_SHOTS,
+    AUTO_MARK_START, AUTO_START,
+    AUTO_MARK_BACK, AUTO_BACK,
+    AUTO_STEP, AUTO_MOTOR_HINT, AUTO_ICON
+};
+
+static widget_t auto_stack_items[] = {
+    [AUTO_HEADER]      = WIDGET_LABEL_INIT(10, 10, "AUTO STACK", &font_large, WHITE),
+    [AUTO_RULE]        = WIDGET_LABEL_INIT(10, 30, "----------", NULL, WHITE),
+    [AUTO_MARK_SHOTS]  = WIDGET_MARKER_INIT(10, 45, ">", YELLOW),
+    [AUTO_SHOTS]       = WIDGET_VALUE_INIT(16, 45, "Shots: ", WHITE),
+    [AUTO_MARK_START]  = WIDGET_MARKER_INIT(10, 55, ">", YELLOW),
+    [AUTO_START]       = WIDGET_LABEL_INIT(16, 55, "Start", NULL, WHITE),
+    [AUTO_MARK_BACK]   = WIDGET_MARKER_INIT(10, 65, ">", YELLOW),
+    [AUTO_BACK]        = WIDGET_LABEL_INIT(16, 65, "Back", NULL, WHITE),
+    [AUTO_STEP]        = WIDGET_VALUE_INIT(10, 85, "Step: ", GREEN),
+    [AUTO_MOTOR_HINT]  = WIDGET_LABEL_INIT(10, 100, "Enable motor first", NULL, RED),
+    [AUTO_ICON]        = WIDGET_IMAGE_INIT(108, 54, &icon_camera),
+};
+
+static const uint8_t auto_stack_markers[] = { AUTO_MARK_SHOTS, AUTO_MARK_START, AUTO_MARK_BACK };
+
+static widget_t auto_stack_screen = WIDGET_SCREEN_INIT(auto_stack_items, BLACK);
+
+// Stack progress. The shot log scrolls in hardware and the status strip
+// along the bottom is drawn into the overlay layer, so the ETA countdown and
+// the progress bar never touch the rest of the screen.
+#define STRIP_ROWS      16
+#define STRIP_Y         (TFT_HEIGHT - STRIP_ROWS)
+
+#if DISPLAY_OVERLAY_ROWS && DISPLAY_OVERLAY_ROWS < STRIP_ROWS
+#error "The stack status strip needs DISPLAY_OVERLAY_ROWS >= 16"
+#endif
+
+enum {
+    PROG_HEADER, PROG_RULE,
+    PROG_POS, PROG_STEP,
+    PROG_HINT
+};
+
+static widget_t progress_items[] = {
+    [PROG_HEADER] = WIDGET_LABEL_INIT(10, 10, "STACKING", &font_large, WHITE),
+    [PROG_RULE]   = WIDGET_LABEL_INIT(10, 30, "--------", NULL, WHITE),
+    [PROG_POS]    = WIDGET_VALUE_INIT(10, 38, "Pos: ", WHITE),
+    [PROG_STEP]   = WIDGET_VALUE_INIT(70, 38, "Step: ", WHITE),
+    [PROG_HINT]   = WIDGET_LABEL_INIT(10, STRIP_Y - 10, "Press: Stop", NULL, YELLOW),
+};
+
+static widget_t progress_screen = WIDGET_SCREEN_INIT(progress_items, BLACK);
+
+enum { STRIP_TEXT, STRIP_BAR };
+
+static widget_t strip_items[] = {
+    [STRIP_TEXT] = { .type = WIDGET_LABEL, .x = 2, .y = STRIP_Y + 1, .color = WHITE, .bg = BLUE,
+                     .dirty = true },
+    [STRIP_BAR]  = WIDGET_BAR_INIT(2, STRIP_Y + 10, TFT_WIDTH - 4, 4, GREEN, BLACK),
+};
+
+static widget_t strip_screen = {
+    .type = WIDGET_SCREEN, .y = STRIP_Y, .w = TFT_WIDTH, .h = STRIP_ROWS, .bg = BLUE,
+    .dirty = true, .children = strip_items, .child_count = sizeof(strip_items) / sizeof(strip_items[0])
+};
+
+// Strip text alternates between two buffers, so the text on the panel is
+// never overwritten before the widget has compared it with the new one
+static char strip_text[2][WIDGET_TEXT_MAX];
+
+static void shot_line(int index, char *buf, int len, void *arg);
+
+static scroll_view_t shot_log = SCROLL_VIEW_INIT(50, 8, 9, NULL, CYAN, shot_line, NULL);
+
+static widget_t *const screens[] = {
+    [MENU_MAIN] = &main_screen,
+    [MENU_MOVE] = &move_screen,
+    [MENU_SETTINGS] = &settings_screen,
+    [MENU_AUTO_STACK] = &auto_stack_screen,
+    [MENU_STACK_PROGRESS] = &progress_screen,
+};
+
+// Private function prototypes
+static void select_item(widget_t *items, const uint8_t *markers, int count, int selection);
+static void update_main_menu(const menu_config_t *cfg);
+static void update_move_menu(const menu_config_t *cfg);
+static void update_settings_menu(const menu_config_t *cfg);
+static void update_auto_stack_menu(const menu_config_t *cfg);
+static void update_stack_progress(const menu_config_t *cfg);
+static void enter_stack_progress(bool enter);
+
+// Draws the menu described by cfg into the framebuffer
+void menu_view_draw(const menu_config_t *cfg) {
+    static widget_t *shown = NULL;
+    widget_t *screen = screens[cfg->current_menu];
+
+    if (screen != shown) {
+        if (shown == &progress_screen || screen == &progress_screen) {
+            enter_stack_progress(screen == &progress_screen);
+        }
+        widget_invalidate(screen);
+        plot_view_invalidate(&move_plot);
+        shown = screen;
+    }
+
+    switch (cfg->current_menu) {
+        case MENU_MAIN:
+            update_main_menu(cfg);
+            break;
+        case MENU_MOVE:
+            update_move_menu(cfg);
+            break;
+        case MENU_SETTINGS:
+            update_settings_menu(cfg);
+            break;
+        case MENU_AUTO_STACK:
+            update_auto_stack_menu(cfg);
+            break;
+        case MENU_STACK_PROGRESS:
+            update_stack_progress(cfg);
+            break;
+    }
+
+    widget_draw(screen);
+    if (cfg->current_menu == MENU_MOVE && cfg->trace) {
+        plot_view_draw(&move_plot);
+    }
+    if (cfg->current_menu == MENU_STACK_PROGRESS) {
+        scroll_view_draw(&shot_log);
+        display_select_layer(DISPLAY_LAYER_OVERLAY);
+        widget_draw(&strip_screen);
+        display_select_layer(DISPLAY_LAYER_BACKGROUND);
+    }
+}
+
+// Each marker is followed by the label it points at
+static void select_item(widget_t *items, const uint8_t *markers, int count, int selection) {
+    for (int i = 0; i < count; i++) {
+        widget_set_selected(&items[markers[i]], i == selection);
+        widget_set_color(&items[markers[i] + 1], i == selection ? YELLOW : WHITE);
+    }
+}
+
+static void update_main_menu(const menu_config_t *cfg) {
+    select_item(main_items, main_markers, sizeof(main_markers), cfg->menu_selection);
+    widget_set_value(&main_items[MAIN_POS], cfg->focus_position);
+    widget_set_value(&main_items[MAIN_STEP], cfg->step_size);
+    widget_set_text(&main_items[MAIN_MOTOR], cfg->motor_enabled ? "Motor: ON" : "Motor: OFF");
+    widget_set_color(&main_items[MAIN_MOTOR], cfg->motor_enabled ? GREEN : RED);
+}
+
+static void update_move_menu(const menu_config_t *cfg) {
+    widget_set_value(&move_items[MOVE_POS], cfg->focus_position);
+    widget_set_value(&move_items[MOVE_STEP], cfg->step_size);
+    widget_set_text(&move_items[MOVE_MOTOR], cfg->motor_enabled ? "Motor: ENABLED" : "Motor: DISABLED");
+    widget_set_color(&move_items[MOVE_MOTOR], cfg->motor_enabled ? GREEN : RED);
+    widget_set_hidden(&move_items[MOVE_MOTOR_HINT], cfg->motor_enabled);
+
+    if (cfg->trace && move_plot.ring != cfg->trace) {
+        move_plot.ring = cfg->trace;
+        plot_view_set_trace(&move_plot, 0, -MOVE_PLOT_POS_SPAN / 2, MOVE_PLOT_POS_SPAN / 2, CYAN, true);
+        plot_view_set_trace(&move_plot, 1, -MOVE_PLOT_SPEED_MAX, MOVE_PLOT_SPEED_MAX, MAGENTA, false);
+    }
+}
+
+static void update_settings_menu(const menu_config_t *cfg) {
+    select_item(settings_items, settings_markers, sizeof(settings_markers), cfg->menu_selection);
+    widget_set_value(&settings_items[SET_STEP_VALUE], cfg->step_size);
+    widget_set_text(&settings_items[SET_MOTOR_STATUS], cfg->motor_enabled ? "  Status: ON" : "  Status: OFF");
+    widget_set_color(&settings_items[SET_MOTOR_STATUS], cfg->motor_enabled ? GREEN : RED);
+}
+
+static void update_auto_stack_menu(const menu_config_t *cfg) {
+    select_item(auto_stack_items, auto_stack_markers, sizeof(auto_stack_markers), cfg->menu_selection);
+    widget_set_value(&auto_stack_items[AUTO_SHOTS], cfg->stack_shots);
+    widget_set_value(&auto_stack_items[AUTO_STEP], cfg->step_size);
+    widget_set_hidden(&auto_stack_items[AUTO_MOTOR_HINT], cfg->motor_enabled);
+}
+
+// Shows or hides the parts of the progress screen that live outside its
+// widget tree
+static void enter_stack_progress(bool enter) {
+    if (enter) {
+        scroll_view_attach(&shot_log);
+        display_overlay_show(STRIP_Y);
+        widget_invalidate(&strip_screen);
+    } else {
+        scroll_view_detach(&shot_log);
+        display_overlay_hide();
+    }
+}
+
+// The shot log and the strip are rebuilt every frame, so they are formatted
+// with numfmt rather than printf, like the widget values.
+
+// Right-aligns value in width columns, padded with pad. Returns the end of
+// the string; like printf, a wider value takes the room it needs.
+static char *put_int(char *dst, int32_t value, int width, char pad) {
+    char digits[NUMFMT_INT_MAX_LEN];
+    int n = numfmt_int(digits, value);
+    for (; width > n; width--) *dst++ = pad;
+    memcpy(dst, digits, n + 1);
+    return dst + n;
+}
+
+static char *put_str(char *dst, const char *str) {
+    int n = strlen(str);
+    memcpy(dst, str, n + 1);
+    return dst + n;
+}
+
+// Copies str into buf of len bytes, cut off to fit
+static void put_cut(char *buf, int len, const char *str) {
+    int n = strlen(str);
+    if (n > len - 1) n = len - 1;
+    memcpy(buf, str, n);
+    buf[n] = '\0';
+}
+
+// "  3   1065   570ms"
+static void shot_line(int index, char *buf, int len, void *arg) {
+    const stack_progress_t *p = arg;
+    const stack_shot_t *shot = &p->log[index % STACK_LOG_SIZE];
+    char line[3 * NUMFMT_INT_MAX_LEN + 4];
+
+    char *end = put_int(line, index + 1, 3, ' ');
+    *end++ = ' ';
+    end = put_int(end, shot->position, 7, ' ');
+    *end++ = ' ';
+    end = put_int(end, (int32_t)shot->cycle_ms, 5, ' ');
+    put_str(end, "ms");
+    put_cut(buf, len, line);
+}
+
+static void update_stack_progress(const menu_config_t *cfg) {
+    static const stack_progress_t idle = { 0 };
+    const stack_progress_t *p = cfg->stack ? cfg->stack : &idle;
+
+    widget_set_text(&progress_items[PROG_HEADER], p->running ? "STACKING" : "STACK DONE");
+    widget_set_value(&progress_items[PROG_POS], p->position);
+    widget_set_value(&progress_items[PROG_STEP], p->step);
+    widget_set_text(&progress_items[PROG_HINT], p->running ? "Press: Stop" : "Press: Back");
+
+    // The log only shows shots the snapshot still holds
+    shot_log.arg = (void *)p;
+    scroll_view_set_count(&shot_log, p->log ? p->shots_done : 0);
+    scroll_view_scroll_to_end(&shot_log);
+
+    widget_t *text = &strip_items[STRIP_TEXT];
+    char *buf = text->text == strip_text[0] ? strip_text[1] : strip_text[0];
+    char line[4 * NUMFMT_INT_MAX_LEN + 8];
+    // "12/50 ETA 0:22"
+    char *end = put_int(line, p->shots_done, 0, ' ');
+    *end++ = '/';
+    end = put_int(end, p->shots_total, 0, ' ');
+    if (p->running && p->avg_cycle_ms) {
+        uint32_t eta_s = (p->eta_ms + 999) / 1000;
+        end = put_str(end, " ETA ");
+        end = put_int(end, (int32_t)(eta_s / 60), 0, ' ');
+        *end++ = ':';
+        put_int(end, (int32_t)(eta_s % 60), 2, '0');
+    }
+    put_cut(buf, WIDGET_TEXT_MAX, line);
+    widget_set_text(text, buf);
+    widget_set_value(&strip_items[STRIP_BAR],
+                     p->shots_total ? p->shots_done * WIDGET_BAR_FULL / p->shots_total : 0);
+}
@@ -0,0 +1,46 @@
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "motion_trace.h"
+#include "stepper.h"
+
+static const char *TAG = "MOTION_TRACE";
+
+static plot_ring_t ring;
+
+// Positions of the last MOTION_TRACE_SPEED_WINDOW samples, for the velocity
+static int history[MOTION_TRACE_SPEED_WINDOW];
+static uint32_t sample_count = 0;
+
+// esp_timer task context. Only reads the live position and pushes into the
+// ring; the render task picks the samples up whenever it gets to them.
+static void sample_cb(void *arg) {
+    int pos = stepper_get_live_position();
+    int slot = sample_count % MOTION_TRACE_SPEED_WINDOW;
+    int oldest = sample_count >= MOTION_TRACE_SPEED_WINDOW ? history[slot] : pos;
+    int32_t v[PLOT_TRACES];
+
+    v[MOTION_TRACE_POSITION] = pos;
+    v[MOTION_TRACE_VELOCITY] = (pos - oldest) * MOTION_TRACE_HZ / MOTION_TRACE_SPEED_WINDOW;
+    history[slot] = pos;
+    sample_count++;
+    plot_ring_push(&ring, v);
+}
+
+void motion_trace_init(void) {
+    const esp_timer_create_args_t args = {
+        .callback = sample_cb,
+        .dispatch_method = ESP_TIMER_TASK,
+        .name = "motion_trace",
+        .skip_unhandled_events = true,
+    };
+    esp_timer_handle_t timer;
+
+    ESP_ERROR_CHECK(esp_timer_create(&args, &timer));
+    ESP_ERROR_CHECK(esp_timer_start_periodic(timer, 1000000 / MOTION_TRACE_HZ));
+    ESP_LOGI(TAG, "Sampling at %d Hz", MOTION_TRACE_HZ);
+}
+
+const plot_ring_t *motion_trace_ring(void) {
+    return &ring;
+}
@@ -0,0 +1,35 @@
+#include "numfmt.h"
+
+// Digits of v, least significant first. Returns the count.
+static int digits_reversed(char *tmp, uint32_t v, int min_digits) {
+    int n = 0;
+    do {
+        tmp[n++] = '0' + v % 10;
+        v /= 10;
+    } while (v || n < min_digits);
+    return n;
+}
+
+int numfmt_int(char *buf, int32_t value) {
+    return numfmt_fixed(buf, value, 0);
+}
+
+// value / 10^decimals, e.g. (-1234, 2) gives "-12.34" and (5, 3) "0.005".
+// decimals above 9 are clamped.
+int numfmt_fixed(char *buf, int32_t value, int decimals) {
+    char tmp[10];
+    uint32_t mag = value < 0 ? 0u - (uint32_t)value : (uint32_t)value;
+    int len = 0;
+
+    if (decimals < 0) decimals = 0;
+    if (decimals > 9) decimals = 9;
+
+    int n = digits_reversed(tmp, mag, decimals + 1);
+    if (value < 0) buf[len++] = '-';
+    while (n > 0) {
+        if (n == decimals) buf[len++] = '.';
+        buf[len++] = tmp[--n];
+    }
+    buf[len] = '\0';
+    return len;
+}
@@ -0,0 +1,184 @@
+#include <stdint.h>
+
+#include "panel.h"
+
+// ST7735-specific commands
+#define ST7735_FRMCTR1      0xB1
+#define ST7735_FRMCTR2      0xB2
+#define ST7735_FRMCTR3      0xB3
+#define ST7735_INVCTR       0xB4
+#define ST7735_PWCTR1       0xC0
+#define ST7735_PWCTR2       0xC1
+#define ST7735_PWCTR3       0xC2
+#define ST7735_PWCTR4       0xC3
+#define ST7735_PWCTR5       0xC4
+#define ST7735_VMCTR1       0xC5
+#define ST7735_GMCTRP1      0xE0
+#define ST7735_GMCTRN1      0xE1
+
+// ST7796S-specific commands
+#define ST7796S_CSCON       0xF0    // Command set control (unlock/lock)
+#define ST7796S_VCMPCTL     0xC5
+#define ST7796S_IFMODE      0xB0
+#define ST7796S_DIC         0xB4
+#define ST7796S_DFC         0xB6
+#define ST7796S_EM          0xB7
+
+// Delays are the datasheet minimums. The hardware reset done by the bus
+// makes a SWRESET redundant. MADCTL is sent afterwards for the rotation.
+#if DISPLAY_PANEL == PANEL_ST7735
+static const uint8_t init_cmds[] = {
+    19,
+    ST77XX_SLPOUT,  PANEL_INIT_DELAY, 120,
+    ST7735_FRMCTR1, 3, 0x01, 0x2C, 0x2D,
+    ST7735_FRMCTR2, 3, 0x01, 0x2C, 0x2D,
+    ST7735_FRMCTR3, 6, 0x01, 0x2C, 0x2D, 0x01, 0x2C, 0x2D,
+    ST7735_INVCTR,  1, 0x07,
+    ST7735_PWCTR1,  3, 0xA2, 0x02, 0x84,
+    ST7735_PWCTR2,  1, 0xC5,
+    ST7735_PWCTR3,  2, 0x0A, 0x00,
+    ST7735_PWCTR4,  2, 0x8A, 0x2A,
+    ST7735_PWCTR5,  2, 0x8A, 0xEE,
+    ST7735_VMCTR1,  1, 0x0E,
+    ST77XX_INVOFF,  0,
+    ST77XX_COLMOD,  1, 0x05,
+    ST77XX_CASET,   4, 0x00, 0x00, 0x00, 0x7F,
+    ST77XX_RASET,   4, 0x00, 0x00, 0x00, 0x9F,
+    ST7735_GMCTRP1, 16, 0x02, 0x1c, 0x07, 0x12, 0x37, 0x32, 0x29, 0x2d,
+                        0x29, 0x25, 0x2B, 0x39, 0x00, 0x01, 0x03, 0x10,
+    ST7735_GMCTRN1, 16, 0x03, 0x1d, 0x07, 0x06, 0x2E, 0x2C, 0x29, 0x2D,
+                        0x2E, 0x2E, 0x37, 0x3F, 0x00, 0x00, 0x02, 0x10,
+    ST77XX_NORON,   PANEL_INIT_DELAY, 10,
+    ST77XX_DISPON,  PANEL_INIT_DELAY, 10,
+};
+
+#define PANEL_NAME          "ST7735"
+#define PANEL_SPI_CLOCK_HZ  (10 * 1000 * 1000)
+#define PANEL_MADCTL        { ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | ST77XX_MADCTL_BGR,  \
+                              ST77XX_MADCTL_MY | ST77XX_MADCTL_MV | ST77XX_MADCTL_BGR,  \
+                              ST77XX_MADCTL_BGR,                                        \
+                              ST77XX_MADCTL_MX | ST77XX_MADCTL_MV | ST77XX_MADCTL_BGR }
+
+#elif DISPLAY_PANEL == PANEL_ST7789
+static const uint8_t init_cmds[] = {
+    6,
+    ST77XX_SLPOUT,  PANEL_INIT_DELAY, 120,
+    ST77XX_COLMOD,  1 | PANEL_INIT_DELAY, 0x55, 10,
+    ST77XX_CASET,   4, 0x00, 0x00, 0x00, 0xEF,
+    ST77XX_RASET,   4, 0x00, 0x00, 0x01, 0x3F,
+    ST77XX_INVON,   PANEL_INIT_DELAY, 10,
+    ST77XX_DISPON,  PANEL_INIT_DELAY, 10,
+};
+
+#define PANEL_NAME          "ST7789"
+#define PANEL_SPI_CLOCK_HZ  (40 * 1000 * 1000)
+#define PANEL_MADCTL        { ST77XX_MADCTL_MX | ST77XX_MADCTL_MY,  \
+                              ST77XX_MADCTL_MY | ST77XX_MADCTL_MV,  \
+                              0,                                    \
+                              ST77XX_MADCTL_MX | ST77XX_MADCTL_MV }
+
+#elif DISPLAY_PANEL == PANEL_ST7796S
+static const uint8_t init_cmds[] = {
+    13,
+    ST7796S_CSCON,  1, 0xC3,            // Unlock manufacturer commands
+    ST7796S_CSCON,  1, 0x96,
+    ST7796S_VCMPCTL, 1, 0x1C,
+    ST77XX_COLMOD,  1, 0x55,
+    ST7796S_IFMODE, 1, 0x80,
+    ST7796S_DIC,    1, 0x00,
+    ST7796S_DFC,    3, 0x80, 0x02, 0x3B,
+    ST7796S_EM,     1, 0xC6,
+    ST7796S_CSCON,  1, 0x69,            // Lock them again
+    ST7796S_CSCON,  1, 0x3C,
+    ST77XX_INVON,   0,
+    ST77XX_SLPOUT,  PANEL_INIT_DELAY, 120,
+    ST77XX_DISPON,  PANEL_INIT_DELAY, 10,
+};
+
+#define PANEL_NAME          "ST7796S"
+#define PANEL_SPI_CLOCK_HZ  (40 * 1000 * 1000)
+#define PANEL_MADCTL        { ST77XX_MADCTL_MX,                                         \
+                              ST77XX_MADCTL_MV,                                         \
+                              ST77XX_MADCTL_MY,                                         \
+                              ST77XX_MADCTL_MX | ST77XX_MADCTL_MY | ST77XX_MADCTL_MV }
+#endif
+
+// Margins on the far side of the glass, used when a rotation mirrors an axis
+#define PANEL_COL_START2    (PANEL_RAM_WIDTH - PANEL_NATIVE_WIDTH - PANEL_COL_START)
+#define PANEL_ROW_START2    (PANEL_RAM_HEIGHT - PANEL_NATIVE_HEIGHT - PANEL_ROW_START)
+
+#if DISPLAY_ROTATION == 0
+#define PANEL_X_OFFSET      PANEL_COL_START
+#define PANEL_Y_OFFSET      PANEL_ROW_START
+#elif DISPLAY_ROTATION == 1
+#define PANEL_X_OFFSET      PANEL_ROW_START
+#define PANEL_Y_OFFSET      PANEL_COL_START2
+#elif DISPLAY_ROTATION == 2
+#define PANEL_X_OFFSET      PANEL_COL_START2
+#define PANEL_Y_OFFSET      PANEL_ROW_START2
+#elif DISPLAY_ROTATION == 3
+#define PANEL_X_OFFSET      PANEL_ROW_START2
+#define PANEL_Y_OFFSET      PANEL_COL_START
+#else
+#error "DISPLAY_ROTATION must be 0..3"
+#endif
+
+static const panel_t panel = {
+    .name = PANEL_NAME,
+    .init_cmds = init_cmds,
+    .spi_clock_hz = PANEL_SPI_CLOCK_HZ,
+    .madctl = PANEL_MADCTL,
+    .x_offset = PANEL_X_OFFSET,
+    .y_offset = PANEL_Y_OFFSET,
+};
+
+const panel_t *panel_get(void) {
+    return &panel;
+}
+
+// CASET/RASET parameters for an inclusive window in drawing coordinates:
+// big-endian 16-bit start and end, moved to where the glass sits in RAM
+void panel_window(const panel_t *p, int x0, int y0, int x1, int y1,
+                  uint8_t caset[4], uint8_t raset[4]) {
+    x0 += p->x_offset;
+    x1 += p->x_offset;
+    y0 += p->y_offset;
+    y1 += p->y_offset;
+
+    caset[0] = x0 >> 8;
+    caset[1] = x0 & 0xFF;
+    caset[2] = x1 >> 8;
+    caset[3] = x1 & 0xFF;
+    raset[0] = y0 >> 8;
+    raset[1] = y0 & 0xFF;
+    raset[2] = y1 >> 8;
+    raset[3] = y1 & 0xFF;
+}
+
+// VSCRDEF/VSCRSADD parameters for a scroll area of drawing rows
+// top..top + height - 1 that shows row start at its top. Frame memory is
+// scanned from line 0 down, so with MY set the drawing rows run bottom-up in
+// it: the area then begins at its last row and wraps the other way.
+void panel_scroll(const panel_t *p, int top, int height, int start,
+                  uint8_t vscrdef[6], uint8_t vscrsadd[2]) {
+    int offset = start - top;
+    int tfa, vsp;
+
+    if (p->madctl[DISPLAY_ROTATION] & ST77XX_MADCTL_MY) {
+        tfa = PANEL_SCROLL_LINES - 1 - (p->y_offset + top + height - 1);
+        vsp = tfa + (height - offset) % height;
+    } else {
+        tfa = p->y_offset + top;
+        vsp = tfa + offset;
+    }
+    int bfa = PANEL_SCROLL_LINES - tfa - height;
+
+    vscrdef[0] = tfa >> 8;
+    vscrdef[1] = tfa & 0xFF;
+    vscrdef[2] = height >> 8;
+    vscrdef[3] = height & 0xFF;
+    vscrdef[4] = bfa >> 8;
+    vscrdef[5] = bfa & 0xFF;
+    vscrsadd[0] = vsp >> 8;
+    vscrsadd[1] = vsp & 0xFF;
+}
@@ -0,0 +1,152 @@
+#include <string.h>
+
+#include "plot_view.h"
+#include "display.h"
+#include "display_fb.h"
+
+// Producer side. Lock free: the slot is complete before head moves past it.
+void plot_ring_push(plot_ring_t *ring, const int32_t v[PLOT_TRACES]) {
+    uint32_t head = ring->head;
+    plot_sample_t *s = &ring->samples[head & (PLOT_RING_SIZE - 1)];
+
+    for (int i = 0; i < PLOT_TRACES; i++) {
+        s->v[i] = v[i];
+    }
+    __atomic_store_n(&ring->head, head + 1, __ATOMIC_RELEASE);
+}
+
+void plot_view_set_trace(plot_view_t *p, int trace, int32_t min, int32_t max, uint16_t color,
+                         bool autoscale) {
+    plot_trace_t *t = &p->traces[trace];
+    t->min = min;
+    t->max = max;
+    t->color = color;
+    t->autoscale = autoscale;
+    p->valid = false;
+}
+
+void plot_view_invalidate(plot_view_t *p) {
+    p->valid = false;
+}
+
+static const plot_sample_t *sample_at(const plot_view_t *p, uint32_t n) {
+    return &p->ring->samples[n & (PLOT_RING_SIZE - 1)];
+}
+
+// Row of value v, clamped to the plot
+static int value_y(const plot_view_t *p, const plot_trace_t *t, int32_t v) {
+    if (v < t->min) v = t->min;
+    if (v > t->max) v = t->max;
+    int64_t span = (int64_t)t->max - t->min;
+    return p->y + p->h - 1 - (int)(((int64_t)v - t->min) * (p->h - 1) / (span ? span : 1));
+}
+
+// Moves autoscaled ranges so they hold samples first..head-1, keeping their
+// span. Returns true if any range moved.
+static bool rescale(plot_view_t *p, uint32_t first, uint32_t head) {
+    bool moved = false;
+    for (int i = 0; i < PLOT_TRACES; i++) {
+        plot_trace_t *t = &p->traces[i];
+        if (!t->autoscale) continue;
+        for (uint32_t n = first; n != head; n++) {
+            int32_t v = sample_at(p, n)->v[i];
+            if (v < t->min || v > t->max) {
+                int32_t span = t->max - t->min;
+                t->min = v - span / 2;
+                t->max = t->min + span;
+                moved = true;
+            }
+        }
+    }
+    return moved;
+}
+
+// False if the traces go into the band mode bitmaps, true if every column
+// is drawn as it comes
+static bool by_column(const plot_view_t *p) {
+#if DISPLAY_BAND_MODE
+    return (p->w + 7) / 8 * p->h > PLOT_BAND_BITS;
+#else
+    return true;
+#endif
+}
+
+// Rows y0..y1 of column col in trace i
+static void trace_span(plot_view_t *p, int i, int col, int y0, int y1) {
+#if DISPLAY_BAND_MODE
+    if (!by_column(p)) {
+        int stride = (p->w + 7) / 8;
+        for (int y = y0; y <= y1; y++) {
+            p->bits[i][(y - p->y) * stride + col / 8] |= 0x80 >> (col & 7);
+        }
+        return;
+    }
+#endif
+    display_draw_vline(p->x + col, y0, y1 - y0 + 1, p->traces[i].color);
+}
+
+// Draws sample n into column n % w, joined to the previous sample, and blanks
+// the gap ahead of it
+static void draw_sample(plot_view_t *p, uint32_t n) {
+    int col = n % p->w;
+    const plot_sample_t *s = sample_at(p, n);
+
+    if (by_column(p)) {
+        for (int g = 1; g <= PLOT_GAP; g++) {
+            display_draw_vline(p->x + (col + g) % p->w, p->y, p->h, p->bg);
+        }
+    }
+    for (int i = 0; i < PLOT_TRACES; i++) {
+        int y = value_y(p, &p->traces[i], s->v[i]);
+        int y0 = p->last_y[i] < y ? p->last_y[i] : y;
+        int y1 = p->last_y[i] > y ? p->last_y[i] : y;
+        trace_span(p, i, col, y0, y1);
+        p->last_y[i] = y;
+    }
+}
+
+void plot_view_draw(plot_view_t *p) {
+    uint32_t head = __atomic_load_n(&p->ring->head, __ATOMIC_ACQUIRE);
+    uint32_t shown = p->w - PLOT_GAP;           // Samples on screen at once
+    uint32_t first = head > shown ? head - shown : 0;
+
+#if DISPLAY_BAND_MODE
+    // The display list only holds what was drawn since the last clear
+    p->valid = false;
+#endif
+    // Too far behind: the columns to draw would wrap onto each other
+    if (p->valid && head - p->drawn > shown) p->valid = false;
+    if (rescale(p, p->valid ? p->drawn : first, head)) p->valid = false;
+
+    if (!p->valid) {
+        display_fill_rect(p->x, p->y, p->w, p->h, p->bg);
+#if DISPLAY_BAND_MODE
+        if (!by_column(p)) memset(p->bits, 0, sizeof(p->bits));
+#endif
+        p->drawn = first;
+        // The oldest column is joined to the sample before it, as it was
+        // when drawn incrementally
+        for (int i = 0; i < PLOT_TRACES; i++) {
+            p->last_y[i] = first > 0 ? value_y(p, &p->traces[i], sample_at(p, first - 1)->v[i])
+                                     : -1;
+        }
+    }
+
+    for (; p->drawn != head; p->drawn++) {
+        if (p->last_y[0] < 0) {
+            const plot_sample_t *s = sample_at(p, p->drawn);
+            for (int i = 0; i < PLOT_TRACES; i++) {
+                p->last_y[i] = value_y(p, &p->traces[i], s->v[i]);
+            }
+        }
+        draw_sample(p, p->drawn);
+    }
+#if DISPLAY_BAND_MODE
+    // Later traces on top, as when drawn column by column
+    for (int i = 0; i < PLOT_TRACES && !by_column(p); i++) {
+        display_draw_bitmap1(p->x, p->y, p->bits[i], p->w, p->h, p->traces[i].color,
+                             p->traces[i].color);
+    }
+#endif
+    p->valid = true;
+}
@@ -0,0 +1,53 @@
+#include <stdio.h>
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+
+#include "render.h"
+#include "display.h"
+
+static const char *TAG = "RENDER";
+
+static TaskHandle_t render_task_handle = NULL;
+static render_draw_fn_t render_draw = NULL;
+
+// The render task is the only code that touches the framebuffer and the
+// display SPI device once it is running. Everything else posts invalidations.
+static void render_task(void *pvParameters) {
+    const TickType_t frame_period = pdMS_TO_TICKS(RENDER_FRAME_PERIOD_MS);
+    TickType_t last_frame = xTaskGetTickCount() - frame_period;
+
+    ESP_LOGI(TAG, "Render task started, %d fps max", RENDER_FPS);
+
+    while (1) {
+        // Rate limit: wait out the rest of the frame period, then take every
+        // request that came in meanwhile along with the current frame
+        if (xTaskGetTickCount() - last_frame < frame_period) {
+            vTaskDelayUntil(&last_frame, frame_period);
+        } else {
+            last_frame = xTaskGetTickCount();
+        }
+        ulTaskNotifyTake(pdTRUE, 0);
+
+        // The previous frame may still be going out over DMA
+        display_flush_wait();
+        render_draw();
+        display_flush_async(NULL, NULL);
+
+        // Sleep until the next invalidation
+        ulTaskNotifyTake(pdTRUE, portMAX_DELAY);
+    }
+}
+
+// Starts the render task. It draws one frame immediately.
+void render_start(render_draw_fn_t draw) {
+    render_draw = draw;
+    xTaskCreate(render_task, "render_task", 4096, NULL, 6, &render_task_handle);
+}
+
+// Requests a redraw. Cheap and safe to call from any task at any rate.
+void render_invalidate(void) {
+    if (render_task_handle != NULL) {
+        xTaskNotifyGive(render_task_handle);
+    }
+}
@@ -0,0 +1,92 @@
+#include <stdlib.h>
+
+#include "scroll_view.h"
+#include "display.h"
+#include "display_fb.h"
+
+// Makes the view's rows the panel's scroll area. Everything is redrawn on
+// the next scroll_view_draw().
+void scroll_view_attach(scroll_view_t *v) {
+    v->slot0 = 0;
+    v->valid = false;
+    display_scroll_area(v->y, v->rows * v->row_h);
+}
+
+// Ends hardware scrolling; the rows show in framebuffer order again
+void scroll_view_detach(scroll_view_t *v) {
+    v->valid = false;
+    display_scroll_area(0, 0);
+}
+
+void scroll_view_set_count(scroll_view_t *v, int count) {
+    v->count = count;
+}
+
+void scroll_view_scroll_to(scroll_view_t *v, int first) {
+    if (first > v->count - v->rows) first = v->count - v->rows;
+    if (first < 0) first = 0;
+    v->first = first;
+}
+
+void scroll_view_scroll_to_end(scroll_view_t *v) {
+    scroll_view_scroll_to(v, v->count);
+}
+
+void scroll_view_invalidate(scroll_view_t *v) {
+    v->valid = false;
+}
+
+// Draws line index into row slot, blank past the last line
+static void draw_line(scroll_view_t *v, int slot, int index) {
+    char text[SCROLL_VIEW_LINE_MAX] = "";
+    int y = v->y + slot * v->row_h;
+
+    if (index < v->count) {
+        v->line(index, text, sizeof(text), v->arg);
+    }
+    display_fill_rect(0, y, TFT_WIDTH, v->row_h, v->bg);
+    if (v->font) {
+        display_draw_text(0, y, text, v->font, v->color, v->bg);
+    } else {
+        display_print_string(0, y, text, v->color, v->bg, 1);
+    }
+}
+
+void scroll_view_draw(scroll_view_t *v) {
+    int delta = v->first - v->shown_first;
+    int fresh0 = 0, fresh1 = v->rows - 1;      // Visible lines to draw
+
+    if (v->valid && delta == 0) {
+        fresh0 = v->rows;
+    } else if (DISPLAY_HW_SCROLL && v->valid && abs(delta) < v->rows) {
+        // Slots that scrolled out take the lines coming in
+        v->slot0 = (v->slot0 + delta + v->rows) % v->rows;
+        if (delta >= 0) {
+            fresh0 = v->rows - delta;
+        } else {
+            fresh1 = -delta - 1;
+        }
+    }
+#if DISPLAY_BAND_MODE
+    // The display list only holds what was drawn since the last clear
+    fresh0 = 0;
+    fresh1 = v->rows - 1;
+#endif
+
+    // Lines added or removed at the end show up without scrolling while
+    // the list is shorter than the window
+    int added0 = v->count < v->shown_count ? v->count : v->shown_count;
+    int added1 = v->count < v->shown_count ? v->shown_count : v->count;
+
+    for (int r = 0; r < v->rows; r++) {
+        int index = v->first + r;
+        if ((r >= fresh0 && r <= fresh1) || (index >= added0 && index < added1)) {
+            draw_line(v, (v->slot0 + r) % v->rows, index);
+        }
+    }
+    display_scroll_to(v->y + v->slot0 * v->row_h);
+
+    v->shown_first = v->first;
+    v->shown_count = v->count;
+    v->valid = true;
+}
@@ -0,0 +1,140 @@
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "stack.h"
+#include "stepper.h"
+#include "render.h"
+
+static const char *TAG = "STACK";
+
+// Written by the stack task only; readers take a snapshot under the lock
+static stack_progress_t progress;
+static stack_shot_t shot_log[STACK_LOG_SIZE];
+static int64_t cycle_start_us;
+static portMUX_TYPE progress_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static volatile bool stop_requested = false;
+
+// Cycle times of the last STACK_CYCLE_WINDOW shots
+static uint32_t cycle_ms[STACK_CYCLE_WINDOW];
+
+static void trigger_camera(void) {
+    gpio_set_level(CAMERA_TRIGGER_PIN, 1);
+    vTaskDelay(pdMS_TO_TICKS(STACK_TRIGGER_MS));
+    gpio_set_level(CAMERA_TRIGGER_PIN, 0);
+}
+
+// The shot loop never waits for the display: it publishes its progress and
+// pokes the render task, which picks it up at its own pace.
+static void stack_task(void *pvParameters) {
+    int shots = progress.shots_total;
+    int step = progress.step;
+    uint32_t window_sum = 0;
+
+    for (int i = 0; i < shots && !stop_requested; i++) {
+        int64_t start = esp_timer_get_time();
+        portENTER_CRITICAL(&progress_lock);
+        cycle_start_us = start;
+        portEXIT_CRITICAL(&progress_lock);
+
+        if (i > 0) stepper_move(step);
+        vTaskDelay(pdMS_TO_TICKS(STACK_SETTLE_MS));
+        trigger_camera();
+        vTaskDelay(pdMS_TO_TICKS(STACK_EXPOSURE_MS));
+
+        uint32_t ms = (uint32_t)((esp_timer_get_time() - start) / 1000);
+        int slot = i % STACK_CYCLE_WINDOW;
+        if (i >= STACK_CYCLE_WINDOW) window_sum -= cycle_ms[slot];
+        cycle_ms[slot] = ms;
+        window_sum += ms;
+        int measured = i < STACK_CYCLE_WINDOW ? i + 1 : STACK_CYCLE_WINDOW;
+
+        // The log entry is complete before shots_done makes it visible
+        shot_log[i % STACK_LOG_SIZE].position = stepper_get_position();
+        shot_log[i % STACK_LOG_SIZE].cycle_ms = ms;
+
+        portENTER_CRITICAL(&progress_lock);
+        progress.shots_done = i + 1;
+        progress.position = stepper_get_position();
+        progress.avg_cycle_ms = window_sum / measured;
+        portEXIT_CRITICAL(&progress_lock);
+        render_invalidate();
+    }
+
+    portENTER_CRITICAL(&progress_lock);
+    progress.running = false;
+    portEXIT_CRITICAL(&progress_lock);
+    render_invalidate();
+
+    ESP_LOGI(TAG, "Stack %s after %d of %d shots", stop_requested ? "stopped" : "done",
+             progress.shots_done, shots);
+    vTaskDelete(NULL);
+}
+
+void stack_init(void) {
+    gpio_config_t io_conf = {};
+    io_conf.intr_type = GPIO_INTR_DISABLE;
+    io_conf.mode = GPIO_MODE_OUTPUT;
+    io_conf.pin_bit_mask = 1ULL << CAMERA_TRIGGER_PIN;
+    gpio_config(&io_conf);
+    gpio_set_level(CAMERA_TRIGGER_PIN, 0);
+
+    progress.log = shot_log;
+    ESP_LOGI(TAG, "Stack control initialized");
+}
+
+// Starts a stack of shots from the current position, step steps apart.
+// Returns false if one is already running or the motor is off.
+bool stack_start(int shots, int step) {
+    if (!stepper_is_enabled() || shots <= 0) return false;
+    int position = stepper_get_position();
+
+    // Checked and claimed under the lock, so two callers cannot both start
+    portENTER_CRITICAL(&progress_lock);
+    if (progress.running) {
+        portEXIT_CRITICAL(&progress_lock);
+        return false;
+    }
+    progress.shots_total = shots;
+    progress.shots_done = 0;
+    progress.position = position;
+    progress.step = step;
+    progress.avg_cycle_ms = 0;
+    progress.running = true;
+    cycle_start_us = esp_timer_get_time();
+    portEXIT_CRITICAL(&progress_lock);
+
+    stop_requested = false;
+    if (xTaskCreate(stack_task, "stack_task", 4096, NULL, 4, NULL) != pdPASS) {
+        portENTER_CRITICAL(&progress_lock);
+        progress.running = false;
+        portEXIT_CRITICAL(&progress_lock);
+        ESP_LOGE(TAG, "Failed to create stack task");
+        return false;
+    }
+    ESP_LOGI(TAG, "Stack of %d shots, %d steps apart", shots, step);
+    return true;
+}
+
+// The current shot is finished first
+void stack_stop(void) {
+    stop_requested = true;
+}
+
+// ETA: remaining cycles at the running average, less the time already spent
+// in the current one. 0 once the stack has ended.
+void stack_get_progress(stack_progress_t *out) {
+    portENTER_CRITICAL(&progress_lock);
+    *out = progress;
+    int64_t in_cycle_ms = (esp_timer_get_time() - cycle_start_us) / 1000;
+    portEXIT_CRITICAL(&progress_lock);
+
+    int64_t eta = 0;
+    if (out->running) {
+        eta = (int64_t)(out->shots_total - out->shots_done) * out->avg_cycle_ms - in_cycle_ms;
+    }
+    out->eta_ms = eta > 0 ? (uint32_t)eta : 0;
+}
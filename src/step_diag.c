@@ -0,0 +1,148 @@
+#include <stdio.h>
+#include <string.h>
+#include "freertos/FreeRTOS.h"
+#include "esp_log.h"
+#include "esp_timer.h"
+
+#include "step_diag.h"
+
+static const char *TAG = "STEP_DIAG";
+
+static const uint32_t hist_bounds_us[STEP_DIAG_HIST_BUCKETS - 1] = STEP_DIAG_HIST_BOUNDS_US;
+
+// Raw rising-edge timestamps (low 32 bits of esp_timer, us), under diag_lock
+static uint32_t edge_ring[STEP_DIAG_RING_SIZE];
+static uint32_t edge_count = 0;
+
+// Running state of the move in progress, only touched by the stepping task
+static step_diag_stats_t current;
+static int64_t first_edge_us;
+static int64_t last_edge_us;
+static uint64_t interval_sum_us;
+static uint32_t last_interval_us;
+
+// Published result of the last completed move
+static step_diag_stats_t last_move;
+static portMUX_TYPE diag_lock = portMUX_INITIALIZER_UNLOCKED;
+
+static int hist_bucket(uint32_t jitter_us) {
+    for (int i = 0; i < STEP_DIAG_HIST_BUCKETS - 1; i++) {
+        if (jitter_us <= hist_bounds_us[i]) return i;
+    }
+    return STEP_DIAG_HIST_BUCKETS - 1;
+}
+
+void step_diag_move_begin(int steps) {
+    memset(&current, 0, sizeof(current));
+    current.requested_steps = steps;
+    current.interval_min_us = UINT32_MAX;
+    interval_sum_us = 0;
+    last_interval_us = 0;
+    first_edge_us = 0;
+    last_edge_us = 0;
+}
+
+// Called right after the STEP pin goes high. Keep this cheap: it sits in the
+// motion path. The lock is held for just the ring slot and count, so a
+// reset or a reader never sees a half-written slot.
+void step_diag_edge(void) {
+    int64_t now = esp_timer_get_time();
+
+    portENTER_CRITICAL(&diag_lock);
+    edge_ring[edge_count & (STEP_DIAG_RING_SIZE - 1)] = (uint32_t)now;
+    edge_count++;
+    portEXIT_CRITICAL(&diag_lock);
+
+    if (current.steps == 0) {
+        first_edge_us = now;
+    } else {
+        uint32_t interval = (uint32_t)(now - last_edge_us);
+        if (interval < current.interval_min_us) current.interval_min_us = interval;
+        if (interval > current.interval_max_us) current.interval_max_us = interval;
+        interval_sum_us += interval;
+
+        if (current.steps > 1) {
+            uint32_t jitter = interval > last_interval_us ? interval - last_interval_us
+                                                          : last_interval_us - interval;
+            if (jitter > current.jitter_max_us) current.jitter_max_us = jitter;
+            current.jitter_hist[hist_bucket(jitter)]++;
+        }
+        last_interval_us = interval;
+    }
+    last_edge_us = now;
+    current.steps++;
+}
+
+void step_diag_move_end(void) {
+    if (current.steps == 0) return;
+
+    current.duration_us = last_edge_us - first_edge_us;
+    if (current.steps > 1) {
+        current.interval_avg_us = (uint32_t)(interval_sum_us / (current.steps - 1));
+        if (current.duration_us > 0) {
+            current.steps_per_sec = (uint32_t)(((uint64_t)(current.steps - 1) * 1000000) / current.duration_us);
+        }
+    } else {
+        current.interval_min_us = 0;
+    }
+
+    portENTER_CRITICAL(&diag_lock);
+    last_move = current;
+    portEXIT_CRITICAL(&diag_lock);
+
+    ESP_LOGI(TAG, "%lu steps, %lu steps/s, interval min/avg/max %lu/%lu/%lu us, jitter max %lu us",
+             (unsigned long)current.steps, (unsigned long)current.steps_per_sec,
+             (unsigned long)current.interval_min_us, (unsigned long)current.interval_avg_us,
+             (unsigned long)current.interval_max_us, (unsigned long)current.jitter_max_us);
+}
+
+void step_diag_get_last_move(step_diag_stats_t *out) {
+    portENTER_CRITICAL(&diag_lock);
+    *out = last_move;
+    portEXIT_CRITICAL(&diag_lock);
+}
+
+// Copies up to max of the most recent edge timestamps, oldest first.
+// Returns the number copied.
+size_t step_diag_get_edges(uint32_t *dst, size_t max) {
+    portENTER_CRITICAL(&diag_lock);
+    uint32_t count = edge_count;
+    size_t n = count < STEP_DIAG_RING_SIZE ? count : STEP_DIAG_RING_SIZE;
+    if (n > max) n = max;
+    for (size_t i = 0; i < n; i++) {
+        dst[i] = edge_ring[(count - n + i) & (STEP_DIAG_RING_SIZE - 1)];
+    }
+    portEXIT_CRITICAL(&diag_lock);
+    return n;
+}
+
+void step_diag_reset(void) {
+    portENTER_CRITICAL(&diag_lock);
+    memset(&last_move, 0, sizeof(last_move));
+    edge_count = 0;
+    portEXIT_CRITICAL(&diag_lock);
+}
+
+void step_diag_print_report(void) {
+    step_diag_stats_t s;
+    step_diag_get_last_move(&s);
+
+    if (s.steps == 0) {
+        printf("No move recorded\n");
+        return;
+    }
+
+    printf("Last move: %d requested, %lu steps in %lld us (%lu steps/s)\n",
+           s.requested_steps, (unsigned long)s.steps, (long long)s.duration_us, (unsigned long)s.steps_per_sec);
+    printf("Interval min/avg/max: %lu / %lu / %lu us\n",
+           (unsigned long)s.interval_min_us, (unsigned long)s.interval_avg_us,
+           (unsigned long)s.interval_max_us);
+    printf("Jitter max: %lu us\n", (unsigned long)s.jitter_max_us);
+    for (int i = 0; i < STEP_DIAG_HIST_BUCKETS; i++) {
+        if (i < STEP_DIAG_HIST_BUCKETS - 1) {
+            printf("  <= %4lu us: %lu\n", (unsigned long)hist_bounds_us[i], (unsigned long)s.jitter_hist[i]);
+        } else {
+            printf("   > %4lu us: %lu\n", (unsigned long)hist_bounds_us[i - 1], (unsigned long)s.jitter_hist[i]);
+        }
+    }
+}
@@ -1,4 +1,5 @@
 #include "stepper.h"
+#include "step_diag.h"
 #include "driver/gpio.h"
 #include "freertos/FreeRTOS.h"
 #include "freertos/task.h"
@@ -11,6 +12,10 @@ static const char *TAG = "STEPPER";
 int focus_position = 0;
 bool motor_enabled = false;
 
+// Position including the steps of a move in progress. Written once per step
+// by the stepping task and read lock free by the motion trace.
+static volatile int live_position = 0;
+
 void stepper_init(void) {
     gpio_config_t io_conf = {};
     io_conf.intr_type = GPIO_INTR_DISABLE;
@@ -50,15 +55,20 @@ void stepper_move(int steps) {
     
     gpio_set_level(DIR_PIN, steps > 0 ? 1 : 0);
     int abs_steps = abs(steps);
+    int dir = steps > 0 ? 1 : -1;
     
     ESP_LOGI(TAG, "Moving %d steps %s", abs_steps, steps > 0 ? "forward" : "backward");
     
+    step_diag_move_begin(steps);
     for (int i = 0; i < abs_steps; i++) {
         gpio_set_level(STEP_PIN, 1);
+        step_diag_edge();
+        live_position += dir;
         vTaskDelay(pdMS_TO_TICKS(2));  // 2ms pulse
         gpio_set_level(STEP_PIN, 0);
         vTaskDelay(pdMS_TO_TICKS(2));  // 2ms delay
     }
+    step_diag_move_end();
     
     focus_position += steps;
     
@@ -71,9 +81,15 @@ int stepper_get_position(void) {
 
 void stepper_reset_position(void) {
     focus_position = 0;
+    live_position = 0;
     ESP_LOGI(TAG, "Position reset to 0");
 }
 
+// Safe to call from any task or timer callback, also during a move
+int stepper_get_live_position(void) {
+    return live_position;
+}
+
 bool stepper_is_enabled(void) {
     return motor_enabled;
 }
\ No newline at end of file
@@ -0,0 +1,179 @@
+#include <string.h>
+
+#include "widget.h"
+#include "display.h"
+#include "display_fb.h"
+#include "numfmt.h"
+
+#define CELL_W  6   // Built-in font advance
+
+// Text the widget should show now, "" when nothing is shown
+static void widget_text(const widget_t *w, char *buf) {
+    const char *src = "";
+    int len;
+
+    buf[0] = '\0';
+    if (w->hidden) return;
+
+    switch (w->type) {
+        case WIDGET_MARKER:
+            if (w->selected) src = w->text;
+            break;
+        default:
+            if (w->text) src = w->text;
+            break;
+    }
+    for (len = 0; src[len] && len < WIDGET_TEXT_MAX - 1; len++) {
+        buf[len] = src[len];
+    }
+    buf[len] = '\0';
+
+    if (w->type == WIDGET_VALUE && len + NUMFMT_FIXED_MAX_LEN <= WIDGET_TEXT_MAX) {
+        numfmt_fixed(&buf[len], w->value, w->decimals);
+    }
+}
+
+static int text_width(const widget_t *w, const char *text) {
+    if (w->font) return font_text_width(w->font, text);
+    return strlen(text) * CELL_W;
+}
+
+// Redraws only what differs from the text already on the panel. With the
+// built-in font that is each changed character cell; with a proportional
+// font everything from the first changed character on, since later glyphs
+// may have moved. Whatever the old text covered beyond the new one is
+// cleared. cleared: the area was just wiped, nothing of the old text is left.
+static void draw_leaf(widget_t *w, bool cleared) {
+    char text[WIDGET_TEXT_MAX];
+    widget_text(w, text);
+
+    if (cleared) w->shown[0] = '\0';
+    bool recolor = w->color != w->shown_color;
+
+    int first = 0;
+    if (!recolor) {
+        while (text[first] && text[first] == w->shown[first]) first++;
+    }
+
+    if (w->font) {
+        if (text[first]) {
+            int x = w->x + font_text_advance(w->font, text, first);
+            display_draw_text(x, w->y, &text[first], w->font, w->color, w->bg);
+        }
+    } else {
+        int old_len = strlen(w->shown);
+        for (int i = first; text[i]; i++) {
+            if (recolor || i >= old_len || text[i] != w->shown[i]) {
+                display_draw_char(w->x + i * CELL_W, w->y, text[i], w->color, w->bg, 1);
+            }
+        }
+    }
+
+    int old_w = text_width(w, w->shown);
+    int new_w = text_width(w, text);
+    if (new_w < old_w) {
+        int h = w->font ? w->font->height : 7;
+        display_fill_rect(w->x + new_w, w->y, old_w - new_w, h, w->bg);
+    }
+
+    memcpy(w->shown, text, sizeof(w->shown));
+    w->shown_color = w->color;
+}
+
+// Transparent pixels show whatever is under the image; a hidden image is
+// cleared to the widget background
+static void draw_image(widget_t *w) {
+    if (w->hidden) {
+        display_fill_rect(w->x, w->y, w->image->w, w->image->h, w->bg);
+    } else {
+        display_draw_image(w->x, w->y, w->image);
+    }
+}
+
+// Grows or shrinks the fill by the columns that changed. A cleared area or
+// a new colour gets the whole bar.
+static void draw_bar(widget_t *w, bool cleared) {
+    int32_t value = w->value < 0 ? 0 : w->value > WIDGET_BAR_FULL ? WIDGET_BAR_FULL : w->value;
+    int fill = w->hidden ? 0 : (int)((int64_t)w->w * value / WIDGET_BAR_FULL);
+    int shown = w->shown_fill;
+
+    if (cleared || w->color != w->shown_color) {
+        display_fill_rect(w->x, w->y, fill, w->h, w->color);
+        display_fill_rect(w->x + fill, w->y, w->w - fill, w->h, w->bg);
+    } else if (fill > shown) {
+        display_fill_rect(w->x + shown, w->y, fill - shown, w->h, w->color);
+    } else if (fill < shown) {
+        display_fill_rect(w->x + fill, w->y, shown - fill, w->h, w->bg);
+    }
+    w->shown_fill = fill;
+    w->shown_color = w->color;
+}
+
+static void draw_tree(widget_t *w, bool cleared) {
+    if (w->dirty || cleared) {
+        if (w->type == WIDGET_SCREEN) {
+            if (w->w == TFT_WIDTH && w->h == TFT_HEIGHT) {
+                display_fill_screen(w->bg);
+            } else {
+                display_fill_rect(w->x, w->y, w->w, w->h, w->bg);
+            }
+            cleared = true;
+        } else if (w->type == WIDGET_IMAGE) {
+            draw_image(w);
+        } else if (w->type == WIDGET_BAR) {
+            draw_bar(w, cleared);
+        } else {
+            draw_leaf(w, cleared);
+        }
+        w->dirty = false;
+    }
+
+    for (int i = 0; i < w->child_count; i++) {
+        draw_tree(&w->children[i], cleared);
+    }
+}
+
+// Redraws w and everything below it on the next widget_draw()
+void widget_invalidate(widget_t *w) {
+    w->dirty = true;
+}
+
+// text must stay unchanged while it is shown; use a value widget for numbers
+void widget_set_text(widget_t *w, const char *text) {
+    if (w->text == text || (w->text && text && strcmp(w->text, text) == 0)) return;
+    w->text = text;
+    w->dirty = true;
+}
+
+void widget_set_color(widget_t *w, uint16_t color) {
+    if (w->color == color) return;
+    w->color = color;
+    w->dirty = true;
+}
+
+void widget_set_value(widget_t *w, int32_t value) {
+    if (w->value == value) return;
+    w->value = value;
+    w->dirty = true;
+}
+
+void widget_set_selected(widget_t *w, bool selected) {
+    if (w->selected == selected) return;
+    w->selected = selected;
+    w->dirty = true;
+}
+
+void widget_set_hidden(widget_t *w, bool hidden) {
+    if (w->hidden == hidden) return;
+    w->hidden = hidden;
+    w->dirty = true;
+}
+
+// Draws whatever changed since the last call
+void widget_draw(widget_t *root) {
+#if DISPLAY_BAND_MODE
+    // The display list only lives for one frame: redraw everything
+    root->dirty = true;
+#endif
+    draw_tree(root, false);
+}
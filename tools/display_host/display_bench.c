@@ -0,0 +1,352 @@
+// Counts the bytes a flush would send over SPI for typical menu transitions.
+//
+//   cc -O2 -Iinclude -Itools/display_host -o display_bench
+//      tools/display_host/display_bench.c tools/display_host/host_bus.c
+//      src/display.c src/dirty_region.c src/dirty_tiles.c src/font.c src/font_data.c
+//      src/widget.c src/numfmt.c src/menu_view.c src/scroll_view.c src/image_data.c
+//      src/plot_view.c
+//
+// (one command line). Every transition used to flush the full 40 KB frame;
+// add -DDIRTY_REGION_MAX_RECTS=1 for the single bounding box behaviour, or
+// -DDISPLAY_DIRTY_TILES=1 [-DDIRTY_TILE_W=.. -DDIRTY_TILE_H=..] for tiles,
+// -DDISPLAY_BAND_MODE=1 for the display list renderer, or -DDISPLAY_FB_BPP=8/4
+// for a palette-indexed framebuffer. The panel checksum column must be the
+// same in every mode, and no draw call may be dropped by a full display
+// list. -DDISPLAY_PANEL=1/2 [-DDISPLAY_ROTATION=0..3] sizes the framebuffer
+// for the ST7789/ST7796S panels.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "display.h"
+#include "dirty_region.h"
+#include "dirty_tiles.h"
+#include "menu_view.h"
+#include "scroll_view.h"
+#include "display_bus.h"
+#include "host_bus.h"
+
+typedef struct {
+    const char *name;
+    menu_config_t cfg;
+} transition_t;
+
+static const transition_t transitions[] = {
+    { "boot -> main",         { 0, 1, false, MENU_MAIN, 0, NULL, 50, NULL } },
+    { "main: select 1",       { 0, 1, false, MENU_MAIN, 1, NULL, 50, NULL } },
+    { "main: select 2",       { 0, 1, false, MENU_MAIN, 2, NULL, 50, NULL } },
+    { "main: select 0",       { 0, 1, false, MENU_MAIN, 0, NULL, 50, NULL } },
+    { "main -> settings",     { 0, 1, false, MENU_SETTINGS, 0, NULL, 50, NULL } },
+    { "settings: step 5",     { 0, 5, false, MENU_SETTINGS, 0, NULL, 50, NULL } },
+    { "settings: select 1",   { 0, 5, false, MENU_SETTINGS, 1, NULL, 50, NULL } },
+    { "settings: motor on",   { 0, 5, true, MENU_SETTINGS, 1, NULL, 50, NULL } },
+    { "settings -> main",     { 0, 5, true, MENU_MAIN, 0, NULL, 50, NULL } },
+    { "main -> move",         { 0, 5, true, MENU_MOVE, 0, NULL, 50, NULL } },
+    { "move: pos 5",          { 5, 5, true, MENU_MOVE, 0, NULL, 50, NULL } },
+    { "move: pos 10",         { 10, 5, true, MENU_MOVE, 0, NULL, 50, NULL } },
+    { "move: pos 15",         { 15, 5, true, MENU_MOVE, 0, NULL, 50, NULL } },
+    { "move -> main",         { 15, 5, true, MENU_MAIN, 0, NULL, 50, NULL } },
+};
+
+// Draw calls dropped by a full display list leave holes in the frame
+static void check_dropped(void) {
+    display_flush_stats_t stats;
+    display_get_flush_stats(&stats);
+    if (stats.dropped) {
+        fprintf(stderr, "%lu draw calls dropped: the display list is full\n",
+                (unsigned long)stats.dropped);
+        exit(1);
+    }
+}
+
+static void reset_stats(void) {
+    check_dropped();
+    display_reset_flush_stats();
+}
+
+// Shot log scrolled a line at a time while shots come in
+#define LOG_LINES       40
+#define LOG_STEPS       10
+
+static void log_line(int index, char *buf, int len, void *arg) {
+    snprintf(buf, len, "Shot %3d %7d um", index + 1, index * 25);
+}
+
+static scroll_view_t log_view = SCROLL_VIEW_INIT(16, 16, 8, NULL, WHITE, log_line, NULL);
+static uint16_t visible[TFT_WIDTH * TFT_HEIGHT];
+static uint16_t repainted[TFT_WIDTH * TFT_HEIGHT];
+
+// Band mode keeps only what was drawn since the last clear
+static void draw_log(void) {
+#if DISPLAY_BAND_MODE
+    display_fill_screen(BLACK);
+#endif
+    scroll_view_draw(&log_view);
+    display_flush_dirty();
+}
+
+static uint32_t log_bench(void) {
+    display_flush_stats_t stats;
+    uint32_t total = 0;
+
+    display_fill_screen(BLACK);
+    scroll_view_attach(&log_view);
+    scroll_view_set_count(&log_view, LOG_LINES);
+    scroll_view_scroll_to_end(&log_view);
+    draw_log();
+
+    for (int i = 1; i <= LOG_STEPS; i++) {
+        reset_stats();
+        scroll_view_set_count(&log_view, LOG_LINES + i);
+        scroll_view_scroll_to_end(&log_view);
+        draw_log();
+        display_get_flush_stats(&stats);
+        total += stats.pixel_bytes + stats.command_bytes;
+    }
+
+    // The scrolled panel must look like a plain repaint of the same lines
+    host_bus_visible(visible);
+    scroll_view_attach(&log_view);
+    draw_log();
+    host_bus_visible(repainted);
+    if (memcmp(visible, repainted, sizeof(visible)) != 0) {
+        fprintf(stderr, "log: scrolled view differs from a repaint\n");
+        exit(1);
+    }
+    scroll_view_detach(&log_view);
+    return total;
+}
+
+// Everything the dirty tracking missed shows up as a panel/framebuffer mismatch.
+// Band mode has no framebuffer; compare its checksums with a default build.
+static void check_panel(const char *name) {
+#if !DISPLAY_BAND_MODE
+    uint16_t row[TFT_WIDTH];
+    for (int y = 0; y < TFT_HEIGHT; y++) {
+        display_fb_expand(row, display_bus_row(host_bus_framebuffer(), host_bus_overlay(), y),
+                          0, 0, TFT_WIDTH);
+        if (memcmp(&host_bus_panel()[y * TFT_WIDTH], row, sizeof(row)) != 0) {
+            fprintf(stderr, "%s: panel does not match framebuffer\n", name);
+            exit(1);
+        }
+    }
+#endif
+}
+
+static uint32_t panel_checksum(void) {
+    const uint8_t *p = (const uint8_t *)host_bus_panel();
+    uint32_t h = 2166136261u;
+    for (int i = 0; i < TFT_WIDTH * TFT_HEIGHT * 2; i++) {
+        h = (h ^ p[i]) * 16777619u;
+    }
+    return h;
+}
+
+#if !DISPLAY_BAND_MODE && DISPLAY_OVERLAY_ROWS
+// Status strip over the move screen, updated once per frame
+#define STRIP_UPDATES   30
+
+static uint16_t before[TFT_WIDTH * TFT_HEIGHT];
+
+static uint32_t strip_bench(void) {
+    const menu_config_t cfg = { 15, 5, true, MENU_MOVE, 0, NULL, 50, NULL };
+    const int y = TFT_HEIGHT - DISPLAY_OVERLAY_ROWS;
+    display_flush_stats_t stats;
+    uint32_t total = 0;
+
+    menu_view_draw(&cfg);
+    display_overlay_show(y);
+    display_select_layer(DISPLAY_LAYER_OVERLAY);
+    display_fill_rect(0, y, TFT_WIDTH, DISPLAY_OVERLAY_ROWS, BLUE);
+    display_select_layer(DISPLAY_LAYER_BACKGROUND);
+    display_flush_dirty();
+    memcpy(before, host_bus_panel(), sizeof(before));
+
+    for (int i = 0; i < STRIP_UPDATES; i++) {
+        char text[24];
+        snprintf(text, sizeof(text), "Pos %6d um", 1000 + i * 7);
+
+        reset_stats();
+        display_select_layer(DISPLAY_LAYER_OVERLAY);
+        display_print_string(2, y + 4, text, WHITE, BLUE, 1);
+        display_select_layer(DISPLAY_LAYER_BACKGROUND);
+        display_flush_dirty();
+        display_get_flush_stats(&stats);
+        total += stats.pixel_bytes + stats.command_bytes;
+        check_panel("strip");
+    }
+
+    // Nothing above the strip may have been sent again
+    if (memcmp(before, host_bus_panel(), y * TFT_WIDTH * sizeof(uint16_t)) != 0) {
+        fprintf(stderr, "strip: background rows changed\n");
+        exit(1);
+    }
+
+    display_overlay_hide();
+    display_flush_dirty();
+    check_panel("strip hidden");
+    return total;
+}
+#endif
+
+// Live trace on the move screen, one sample per frame
+#define PLOT_FRAMES     150
+
+static plot_ring_t trace;
+static uint16_t plotted[TFT_WIDTH * TFT_HEIGHT];
+
+static uint32_t plot_bench(void) {
+    const menu_config_t main_cfg = { 15, 5, true, MENU_MAIN, 0, NULL, 50, NULL };
+    menu_config_t cfg = { 15, 5, true, MENU_MOVE, 0, &trace, 50, NULL };
+    display_flush_stats_t stats;
+    uint32_t total = 0;
+    int32_t last = 0;
+
+    menu_view_draw(&cfg);
+    display_flush_dirty();
+
+    for (int i = 0; i < PLOT_FRAMES; i++) {
+        // Back and forth over 240 steps, past the initial range
+        int32_t pos = (i * 6) % 480 < 240 ? (i * 6) % 240 : 240 - (i * 6) % 240;
+        int32_t v[PLOT_TRACES] = { pos - 40, (pos - last) * 50 };
+        last = pos;
+        plot_ring_push(&trace, v);
+
+        reset_stats();
+        menu_view_draw(&cfg);
+        display_flush_dirty();
+        display_get_flush_stats(&stats);
+        total += stats.pixel_bytes + stats.command_bytes;
+        check_panel("plot");
+    }
+
+    // Drawn column by column, the plot must look like a full redraw
+    memcpy(plotted, host_bus_panel(), sizeof(plotted));
+    menu_view_draw(&main_cfg);
+    menu_view_draw(&cfg);
+    display_flush_dirty();
+    if (memcmp(plotted, host_bus_panel(), sizeof(plotted)) != 0) {
+        fprintf(stderr, "plot: incremental trace differs from a redraw\n");
+        exit(1);
+    }
+    return total;
+}
+
+// Stack progress: a shot every STACK_FRAMES_PER_SHOT frames, the ETA counting
+// down in between
+#define STACK_SHOTS             30
+#define STACK_FRAMES_PER_SHOT   4
+
+static stack_shot_t shots[STACK_LOG_SIZE];
+static stack_progress_t progress = { .shots_total = STACK_SHOTS, .step = 25, .running = true,
+                                     .log = shots };
+
+static uint32_t stack_bench(uint32_t *shot_bytes) {
+    const menu_config_t main_cfg = { 15, 5, true, MENU_MAIN, 0, NULL, 50, NULL };
+    const menu_config_t cfg = { 15, 5, true, MENU_STACK_PROGRESS, 0, NULL, 50, &progress };
+    display_flush_stats_t stats;
+    uint32_t eta_total = 0;
+
+    *shot_bytes = 0;
+    menu_view_draw(&cfg);
+    display_flush_dirty();
+
+    for (int i = 0; i < STACK_SHOTS * STACK_FRAMES_PER_SHOT; i++) {
+        bool shot = i % STACK_FRAMES_PER_SHOT == STACK_FRAMES_PER_SHOT - 1;
+        if (shot) {
+            int n = progress.shots_done++;
+            shots[n % STACK_LOG_SIZE].position = 15 + n * progress.step;
+            shots[n % STACK_LOG_SIZE].cycle_ms = 560 + n % 3 * 10;
+            progress.position = shots[n % STACK_LOG_SIZE].position;
+            progress.avg_cycle_ms = 570;
+        }
+        progress.eta_ms = (STACK_SHOTS - progress.shots_done) * 570 - i % STACK_FRAMES_PER_SHOT * 140;
+
+        reset_stats();
+        menu_view_draw(&cfg);
+        display_flush_dirty();
+        display_get_flush_stats(&stats);
+        if (shot) {
+            *shot_bytes += stats.pixel_bytes + stats.command_bytes;
+        } else {
+            eta_total += stats.pixel_bytes + stats.command_bytes;
+        }
+        check_panel("stack");
+    }
+
+    // Incremental updates must leave what a fresh draw of the screen shows
+    host_bus_visible(visible);
+    menu_view_draw(&main_cfg);
+    menu_view_draw(&cfg);
+    display_flush_dirty();
+    host_bus_visible(repainted);
+    if (memcmp(visible, repainted, sizeof(visible)) != 0) {
+        fprintf(stderr, "stack: incremental progress differs from a redraw\n");
+        exit(1);
+    }
+    menu_view_draw(&main_cfg);
+    display_flush_dirty();
+    return eta_total;
+}
+
+int main(void) {
+    display_flush_stats_t stats;
+    uint32_t total_bytes = 0;
+
+    display_init();
+    display_flush_dirty();
+
+#if DISPLAY_BAND_MODE
+    printf("band mode\n\n");
+#elif DISPLAY_FB_INDEXED
+    printf("%d bpp, dirty rects: %d\n\n", DISPLAY_FB_BPP, DIRTY_REGION_MAX_RECTS);
+#elif DISPLAY_DIRTY_TILES
+    printf("dirty tiles: %dx%d\n\n", DIRTY_TILE_W, DIRTY_TILE_H);
+#else
+    printf("dirty rects: %d\n\n", DIRTY_REGION_MAX_RECTS);
+#endif
+    printf("%-22s %8s %10s %10s %10s\n", "transition", "windows", "bytes", "vs full", "panel");
+
+    for (size_t i = 0; i < sizeof(transitions) / sizeof(transitions[0]); i++) {
+        const transition_t *t = &transitions[i];
+
+        reset_stats();
+        menu_view_draw(&t->cfg);
+        display_flush_dirty();
+        display_get_flush_stats(&stats);
+        check_panel(t->name);
+
+        uint32_t bytes = stats.pixel_bytes + stats.command_bytes;
+        total_bytes += bytes;
+        printf("%-22s %8lu %10lu %9.1f%%   %08lx\n", t->name, (unsigned long)stats.windows,
+               (unsigned long)bytes, 100.0 * bytes / (TFT_WIDTH * TFT_HEIGHT * 2),
+               (unsigned long)panel_checksum());
+    }
+
+    printf("\ntotal %lu bytes over %zu transitions\n", (unsigned long)total_bytes,
+           sizeof(transitions) / sizeof(transitions[0]));
+
+#if !DISPLAY_BAND_MODE && DISPLAY_OVERLAY_ROWS
+    uint32_t strip_bytes = strip_bench();
+    printf("status strip: %lu bytes per update (strip %d)\n",
+           (unsigned long)(strip_bytes / STRIP_UPDATES), TFT_WIDTH * DISPLAY_OVERLAY_ROWS * 2);
+#endif
+
+    uint32_t plot_bytes = plot_bench();
+    printf("live plot: %lu bytes per sample (plot %d)\n", (unsigned long)(plot_bytes / PLOT_FRAMES),
+           108 * 34 * 2);
+
+    uint32_t shot_bytes;
+    uint32_t eta_bytes = stack_bench(&shot_bytes);
+    printf("stack progress: %lu bytes per shot, %lu per ETA tick\n",
+           (unsigned long)(shot_bytes / STACK_SHOTS),
+           (unsigned long)(eta_bytes / (STACK_SHOTS * (STACK_FRAMES_PER_SHOT - 1))));
+
+    uint32_t log_bytes = log_bench();
+    printf("log scroll: %lu bytes per line (repaint %d)\n", (unsigned long)(log_bytes / LOG_STEPS),
+           log_view.rows * log_view.row_h * TFT_WIDTH * 2);
+    check_dropped();
+    return 0;
+}
@@ -0,0 +1,193 @@
+// Renders every menu screen through the host bus and compares the visible
+// panel byte for byte with the reference frames in
+// tools/display_host/golden/<width>x<height>/<screen>.ppm.
+//
+//   cc -O2 -Iinclude -Itools/display_host -o golden
+//      tools/display_host/golden.c tools/display_host/host_bus.c
+//      src/display.c src/dirty_region.c src/dirty_tiles.c src/font.c src/font_data.c
+//      src/widget.c src/numfmt.c src/menu_view.c src/scroll_view.c src/image_data.c
+//      src/plot_view.c
+//
+// (one command line). Run from the repository root; ./golden --update writes
+// the current frames as the new references, and a directory argument reads
+// or writes them elsewhere. Every framebuffer mode must match the same
+// references; golden.sh checks them all. Afterwards each screen is drawn in
+// full again to report the render time and the bytes a full flush sends.
+// Draw calls dropped by a full display list fail the run as well.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+#include <sys/stat.h>
+
+#include "display.h"
+#include "menu_view.h"
+#include "host_bus.h"
+
+#define ROUNDS          20
+
+typedef struct {
+    const char *name;
+    menu_config_t cfg;
+} golden_screen_t;
+
+static plot_ring_t trace;
+static stack_shot_t shots[STACK_LOG_SIZE];
+static stack_progress_t running = { .shots_total = 50, .shots_done = 12, .position = 1315,
+                                    .step = 25, .avg_cycle_ms = 570, .eta_ms = 21800,
+                                    .running = true, .log = shots };
+static stack_progress_t done = { .shots_total = 50, .shots_done = 50, .position = 2265,
+                                 .step = 25, .avg_cycle_ms = 565, .log = shots };
+
+// Screens in drawing order. Consecutive screens of the same menu are drawn
+// as incremental updates, like on the device.
+static const golden_screen_t screens[] = {
+    { "main",           { 1040, 5, false, MENU_MAIN, 0, NULL, 50, NULL } },
+    { "main_motor_on",  { 1040, 5, true, MENU_MAIN, 2, NULL, 50, NULL } },
+    { "move",           { 1040, 5, true, MENU_MOVE, 0, &trace, 50, NULL } },
+    { "move_disabled",  { 1040, 5, false, MENU_MOVE, 0, &trace, 50, NULL } },
+    { "settings",       { 1040, 50, true, MENU_SETTINGS, 1, NULL, 50, NULL } },
+    { "auto_stack",     { 1040, 25, false, MENU_AUTO_STACK, 1, NULL, 100, NULL } },
+    { "stack_progress", { 1040, 25, true, MENU_STACK_PROGRESS, 0, NULL, 50, &running } },
+    { "stack_done",     { 1040, 25, true, MENU_STACK_PROGRESS, 0, NULL, 50, &done } },
+};
+
+#define SCREEN_COUNT    (sizeof(screens) / sizeof(screens[0]))
+
+static uint8_t frame[HOST_BUS_PPM_SIZE_MAX];
+static uint8_t reference[HOST_BUS_PPM_SIZE_MAX];
+
+// Draw calls dropped by a full display list leave holes in the frame
+static void check_dropped(void) {
+    display_flush_stats_t stats;
+    display_get_flush_stats(&stats);
+    if (stats.dropped) {
+        fprintf(stderr, "%lu draw calls dropped: the display list is full\n",
+                (unsigned long)stats.dropped);
+        exit(1);
+    }
+}
+
+static void reset_stats(void) {
+    check_dropped();
+    display_reset_flush_stats();
+}
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Fixed sample data, so every run draws the same frames
+static void fill_data(void) {
+    for (int i = 0; i < 150; i++) {
+        int32_t pos = (i * 6) % 480 < 240 ? (i * 6) % 240 : 240 - (i * 6) % 240;
+        int32_t v[PLOT_TRACES] = { 1000 + pos, (i * 6) % 480 < 240 ? 300 : -300 };
+        plot_ring_push(&trace, v);
+    }
+    for (int i = 0; i < STACK_LOG_SIZE; i++) {
+        shots[i].position = 1040 + i * 25;
+        shots[i].cycle_ms = 560 + i % 3 * 10;
+    }
+}
+
+// Returns the reference length, 0 if there is none
+static size_t read_reference(const char *path) {
+    FILE *f = fopen(path, "rb");
+    if (!f) return 0;
+    size_t len = fread(reference, 1, sizeof(reference), f);
+    fclose(f);
+    return len;
+}
+
+static void draw(const menu_config_t *cfg) {
+    menu_view_draw(cfg);
+    display_flush_dirty();
+}
+
+int main(int argc, char **argv) {
+    const char *dir = "tools/display_host/golden";
+    bool update = false;
+    int failed = 0;
+
+    for (int i = 1; i < argc; i++) {
+        if (strcmp(argv[i], "--update") == 0) {
+            update = true;
+        } else {
+            dir = argv[i];
+        }
+    }
+
+    if (update) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%dx%d", dir, TFT_WIDTH, TFT_HEIGHT);
+        mkdir(dir, 0755);
+        mkdir(path, 0755);
+    }
+
+    fill_data();
+    display_init();
+    display_flush_dirty();
+
+    printf("%-16s %8s\n", "screen", "result");
+    for (size_t i = 0; i < SCREEN_COUNT; i++) {
+        char path[256];
+        snprintf(path, sizeof(path), "%s/%dx%d/%s.ppm", dir, TFT_WIDTH, TFT_HEIGHT, screens[i].name);
+
+        draw(&screens[i].cfg);
+        size_t len = host_bus_ppm(frame);
+
+        const char *result;
+        if (update) {
+            result = host_bus_write_ppm(path) == 0 ? "written" : "NO FILE";
+        } else {
+            size_t ref_len = read_reference(path);
+            if (ref_len == 0) {
+                result = "MISSING";
+            } else if (ref_len != len || memcmp(frame, reference, len) != 0) {
+                result = "DIFFERS";
+                snprintf(path, sizeof(path), "%s.ppm", screens[i].name);
+                host_bus_write_ppm(path);
+            } else {
+                result = "ok";
+            }
+        }
+        if (strcmp(result, "ok") != 0 && strcmp(result, "written") != 0) failed++;
+        printf("%-16s %8s\n", screens[i].name, result);
+    }
+
+    // Full draws: switch to another menu first (the first or the last screen)
+    // so the screen is drawn whole
+    printf("\n%-16s %10s %10s\n", "screen", "draw us", "bytes");
+    for (size_t i = 0; i < SCREEN_COUNT; i++) {
+        const menu_config_t *cfg = &screens[i].cfg;
+        const golden_screen_t *away = &screens[0];
+        if (cfg->current_menu == away->cfg.current_menu) away = &screens[SCREEN_COUNT - 1];
+        display_flush_stats_t stats;
+        double best = 0;
+
+        for (int round = 0; round < ROUNDS; round++) {
+            draw(&away->cfg);
+            reset_stats();
+            double t0 = now_ns();
+            menu_view_draw(cfg);
+            double t = now_ns() - t0;
+            display_flush_dirty();
+            display_get_flush_stats(&stats);
+            if (round == 0 || t < best) best = t;
+        }
+        printf("%-16s %10.1f %10lu\n", screens[i].name, best / 1000,
+               (unsigned long)(stats.pixel_bytes + stats.command_bytes));
+    }
+
+    check_dropped();
+    if (failed) {
+        fprintf(stderr, "\n%d screen(s) do not match; differing frames were written to the "
+                "current directory\n", failed);
+        return 1;
+    }
+    return 0;
+}
@@ -0,0 +1,19 @@
+#!/bin/sh
+# Builds the golden-image runner for every framebuffer mode and checks each
+# against the same reference frames. Run from the repository root; extra
+# arguments go to the compiler, e.g. -DDIRTY_REGION_MAX_RECTS=1.
+set -e
+
+SRC="tools/display_host/golden.c tools/display_host/host_bus.c src/display.c
+     src/dirty_region.c src/dirty_tiles.c src/font.c src/font_data.c src/widget.c
+     src/numfmt.c src/menu_view.c src/scroll_view.c src/image_data.c src/plot_view.c"
+OUT=${TMPDIR:-/tmp}
+status=0
+
+for mode in "" -DDISPLAY_FB_BPP=8 -DDISPLAY_FB_BPP=4 -DDISPLAY_DIRTY_TILES=1 \
+            -DDISPLAY_BAND_MODE=1 -DDISPLAY_OVERLAY_ROWS=0 -DDISPLAY_GENERIC_RASTER=1; do
+    echo "== ${mode:-default}"
+    cc -O2 -Iinclude -Itools/display_host $mode "$@" -o "$OUT/golden" $SRC
+    "$OUT/golden" || status=1
+done
+exit $status
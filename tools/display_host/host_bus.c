@@ -0,0 +1,103 @@
+// Host implementation of display_bus.h. Flushes complete synchronously and
+// copy the dirty rectangles into a shadow of the panel's RAM, so tools can
+// inspect exactly what the panel would show.
+
+#include <stdio.h>
+#include <string.h>
+
+#include "display_bus.h"
+#include "host_bus.h"
+
+static uint16_t panel_ram[TFT_WIDTH * TFT_HEIGHT];
+static const display_fb_t *last_fb = NULL;
+static display_scroll_t scroll = { 0, TFT_HEIGHT, 0 };
+static display_overlay_t overlay = { NULL, 0, 0 };
+
+void display_bus_init(void) {
+    memset(panel_ram, 0, sizeof(panel_ram));
+    scroll.top = 0;
+    scroll.height = TFT_HEIGHT;
+    scroll.start = 0;
+}
+
+void display_bus_flush(const display_fb_t *fb, const dirty_rect_t *rects, int count,
+                       display_flush_cb_t cb, void *arg) {
+    last_fb = fb;
+    for (int i = 0; i < count; i++) {
+        const dirty_rect_t *r = &rects[i];
+        int w = r->x1 - r->x0 + 1;
+        for (int y = r->y0; y <= r->y1; y++) {
+            display_fb_expand(&panel_ram[y * TFT_WIDTH + r->x0], display_bus_row(fb, &overlay, y),
+                              r->x0, 0, w);
+        }
+    }
+    if (cb) cb(arg);
+}
+
+void display_bus_flush_rows(const uint16_t *rows, int y0, int y1,
+                            display_flush_cb_t cb, void *arg) {
+    memcpy(&panel_ram[y0 * TFT_WIDTH], rows, (y1 - y0 + 1) * TFT_WIDTH * sizeof(uint16_t));
+    if (cb) cb(arg);
+}
+
+void display_bus_wait(void) {
+}
+
+void display_bus_overlay(const display_overlay_t *ov) {
+    overlay = *ov;
+}
+
+const display_overlay_t *host_bus_overlay(void) {
+    return &overlay;
+}
+
+// Flushes complete at once, so this can take effect straight away
+void display_bus_scroll(const display_scroll_t *s) {
+    scroll = *s;
+}
+
+const uint16_t *host_bus_panel(void) {
+    return panel_ram;
+}
+
+const display_fb_t *host_bus_framebuffer(void) {
+    return last_fb;
+}
+
+// What the glass shows: panel RAM with the scroll area rotated
+void host_bus_visible(uint16_t *dst) {
+    for (int y = 0; y < TFT_HEIGHT; y++) {
+        int src = y;
+        if (y >= scroll.top && y < scroll.top + scroll.height) {
+            src = scroll.top + (scroll.start - scroll.top + y - scroll.top) % scroll.height;
+        }
+        memcpy(&dst[y * TFT_WIDTH], &panel_ram[src * TFT_WIDTH], TFT_WIDTH * sizeof(uint16_t));
+    }
+}
+
+size_t host_bus_ppm(uint8_t *dst) {
+    static uint16_t visible[TFT_WIDTH * TFT_HEIGHT];
+    int len = snprintf((char *)dst, HOST_BUS_PPM_HEADER_MAX, "P6\n%d %d\n255\n", TFT_WIDTH, TFT_HEIGHT);
+    uint8_t *p = dst + len;
+
+    // Panel byte order RGB565 to RGB888, low bits filled from the high ones
+    host_bus_visible(visible);
+    for (int i = 0; i < TFT_WIDTH * TFT_HEIGHT; i++) {
+        uint16_t v = (uint16_t)((visible[i] >> 8) | (visible[i] << 8));
+        uint8_t r = (v >> 11) & 0x1F, g = (v >> 5) & 0x3F, b = v & 0x1F;
+        *p++ = (uint8_t)((r << 3) | (r >> 2));
+        *p++ = (uint8_t)((g << 2) | (g >> 4));
+        *p++ = (uint8_t)((b << 3) | (b >> 2));
+    }
+    return p - dst;
+}
+
+int host_bus_write_ppm(const char *path) {
+    static uint8_t ppm[HOST_BUS_PPM_SIZE_MAX];
+    size_t len = host_bus_ppm(ppm);
+    FILE *f = fopen(path, "wb");
+
+    if (!f) return -1;
+    size_t written = fwrite(ppm, 1, len, f);
+    return (fclose(f) == 0 && written == len) ? 0 : -1;
+}
@@ -0,0 +1,30 @@
+#ifndef HOST_BUS_H
+#define HOST_BUS_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "display_fb.h"
+#include "display_bus.h"
+
+// Panel RAM as last flushed, TFT_WIDTH x TFT_HEIGHT in panel byte order
+const uint16_t *host_bus_panel(void);
+
+// Framebuffer passed to the most recent flush, in the display_fb.h format
+const display_fb_t *host_bus_framebuffer(void);
+
+// Overlay passed to the most recent flush
+const display_overlay_t *host_bus_overlay(void);
+
+// The panel as seen through the hardware scroll, TFT_WIDTH x TFT_HEIGHT
+void host_bus_visible(uint16_t *dst);
+
+// The visible panel as a binary PPM (P6, 8 bits per channel)
+#define HOST_BUS_PPM_HEADER_MAX 32
+#define HOST_BUS_PPM_SIZE_MAX   (HOST_BUS_PPM_HEADER_MAX + TFT_WIDTH * TFT_HEIGHT * 3)
+
+// Writes the PPM into dst (HOST_BUS_PPM_SIZE_MAX bytes) and returns its length
+size_t host_bus_ppm(uint8_t *dst);
+// Returns 0 on success, -1 if the file could not be written
+int host_bus_write_ppm(const char *path);
+
+#endif // HOST_BUS_H
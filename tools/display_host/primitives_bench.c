@@ -0,0 +1,319 @@
+// Times the block primitives and the text path against drawing the same
+// shapes one display_draw_pixel() at a time, and the run-length image decoder
+// against plain RGB565 bitmaps.
+//
+//   cc -O2 -Iinclude -Itools/display_host -o primitives_bench
+//      tools/display_host/primitives_bench.c tools/display_host/host_bus.c
+//      src/display.c src/dirty_region.c src/dirty_tiles.c src/font.c src/font_data.c
+//      src/image_data.c
+//
+// (one command line). The same -D options as display_bench apply. Each case
+// first checks that both paths leave the same pixels on the panel.
+// raster_compare.sh runs it against the specialised and the generic
+// (-DDISPLAY_GENERIC_RASTER=1) raster core.
+
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+#include "display.h"
+#include "font5x7.h"
+#include "host_bus.h"
+
+#define ITERATIONS      2000
+#define ROUNDS          5
+
+#if DISPLAY_BAND_MODE
+#error "The per-pixel reference path does not fit in the band mode display list"
+#endif
+
+typedef void (*draw_fn_t)(uint16_t color);
+
+typedef struct {
+    const char *name;
+    int pixels;
+    draw_fn_t per_pixel;
+    draw_fn_t block;
+} bench_case_t;
+
+static uint16_t sprite16[32 * 32];
+static uint8_t sprite1[32 * 4];
+
+static void pp_rect(int x, int y, int w, int h, uint16_t color) {
+    for (int j = 0; j < h; j++) {
+        for (int i = 0; i < w; i++) {
+            display_draw_pixel(x + i, y + j, color);
+        }
+    }
+}
+
+static void pp_fill_screen(uint16_t c) { pp_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, c); }
+static void bl_fill_screen(uint16_t c) { display_fill_rect(0, 0, TFT_WIDTH, TFT_HEIGHT, c); }
+static void pp_fill_64x32(uint16_t c) { pp_rect(33, 40, 64, 32, c); }
+static void bl_fill_64x32(uint16_t c) { display_fill_rect(33, 40, 64, 32, c); }
+static void pp_hline(uint16_t c) { pp_rect(0, 77, TFT_WIDTH, 1, c); }
+static void bl_hline(uint16_t c) { display_draw_hline(0, 77, TFT_WIDTH, c); }
+static void pp_vline(uint16_t c) { pp_rect(61, 0, 1, TFT_HEIGHT, c); }
+static void bl_vline(uint16_t c) { display_draw_vline(61, 0, TFT_HEIGHT, c); }
+
+static void pp_outline(uint16_t c) {
+    pp_rect(10, 10, 100, 1, c);
+    pp_rect(10, 129, 100, 1, c);
+    pp_rect(10, 11, 1, 118, c);
+    pp_rect(109, 11, 1, 118, c);
+}
+static void bl_outline(uint16_t c) { display_draw_rect(10, 10, 100, 120, c); }
+
+// Colour picks the sprite variant so consecutive iterations differ
+static void pp_bitmap16(uint16_t c) {
+    for (int j = 0; j < 32; j++) {
+        for (int i = 0; i < 32; i++) {
+            display_draw_pixel(50 + i, 60 + j, sprite16[j * 32 + i] ^ c);
+        }
+    }
+}
+static void bl_bitmap16(uint16_t c) {
+    static uint16_t tmp[32 * 32];
+    for (int i = 0; i < 32 * 32; i++) tmp[i] = sprite16[i] ^ c;
+    display_draw_bitmap16(50, 60, tmp, 32, 32);
+}
+
+static void pp_bitmap1(uint16_t c) {
+    for (int j = 0; j < 32; j++) {
+        for (int i = 0; i < 32; i++) {
+            bool set = sprite1[j * 4 + i / 8] & (0x80 >> (i & 7));
+            display_draw_pixel(50 + i, 60 + j, set ? c : BLACK);
+        }
+    }
+}
+static void bl_bitmap1(uint16_t c) { display_draw_bitmap1(50, 60, sprite1, 32, 32, c, BLACK); }
+
+static const bench_case_t cases[] = {
+    { "fill 128x160",   TFT_WIDTH * TFT_HEIGHT, pp_fill_screen, bl_fill_screen },
+    { "fill 64x32",     64 * 32,                pp_fill_64x32,  bl_fill_64x32 },
+    { "hline 128",      TFT_WIDTH,              pp_hline,       bl_hline },
+    { "vline 160",      TFT_HEIGHT,             pp_vline,       bl_vline },
+    { "rect 100x120",   2 * 100 + 2 * 118,      pp_outline,     bl_outline },
+    { "bitmap16 32x32", 32 * 32,                pp_bitmap16,    bl_bitmap16 },
+    { "bitmap1 32x32",  32 * 32,                pp_bitmap1,     bl_bitmap1 },
+};
+
+// Text: 16 lines of TEXT_LINE at the given size
+#define TEXT_LINE       "Pos 12345 um"
+#define TEXT_LINE_LEN   12
+
+static const uint8_t font_columns[][5] = {
+#define FONT_COLUMNS(a, b, c, d, e) { a, b, c, d, e },
+    FONT5X7(FONT_COLUMNS)
+};
+
+// The text path as it was: column-major glyphs, one pixel at a time
+static void pp_char(int x, int y, char c, uint16_t color, uint16_t bg, int size) {
+    const uint8_t *glyph = font_columns[c - FONT5X7_FIRST];
+    for (int i = 0; i < 5; i++) {
+        uint8_t line = glyph[i];
+        for (int j = 0; j < 7; j++) {
+            if ((line & 1) || bg != color) {
+                uint16_t pc = (line & 1) ? color : bg;
+                for (int a = 0; a < size; a++) {
+                    for (int b = 0; b < size; b++) {
+                        display_draw_pixel(x + i * size + a, y + j * size + b, pc);
+                    }
+                }
+            }
+            line >>= 1;
+        }
+    }
+}
+
+static int text_size;
+static bool text_opaque;
+
+static int text_lines(void) {
+    int lines = TFT_HEIGHT / (8 * text_size);
+    return lines > 16 ? 16 : lines;
+}
+
+static int text_chars(void) {
+    int per_line = TFT_WIDTH / (6 * text_size);
+    return text_lines() * (per_line < TEXT_LINE_LEN ? per_line : TEXT_LINE_LEN);
+}
+
+static void pp_text(uint16_t c) {
+    int n = text_chars() / text_lines();
+    for (int l = 0; l < text_lines(); l++) {
+        for (int i = 0; i < n; i++) {
+            pp_char(i * 6 * text_size, l * 8 * text_size, TEXT_LINE[i], c,
+                    text_opaque ? BLACK : c, text_size);
+        }
+    }
+}
+
+static void bl_text(uint16_t c) {
+    int n = text_chars() / text_lines();
+    for (int l = 0; l < text_lines(); l++) {
+        for (int i = 0; i < n; i++) {
+            display_draw_char(i * 6 * text_size, l * 8 * text_size, TEXT_LINE[i], c,
+                              text_opaque ? BLACK : c, text_size);
+        }
+    }
+}
+
+static const struct {
+    const char *name;
+    int size;
+    bool opaque;
+} text_cases[] = {
+    { "size 1 opaque",  1, true },
+    { "size 1 clear",   1, false },
+    { "size 2 opaque",  2, true },
+    { "size 2 clear",   2, false },
+    { "size 3 opaque",  3, true },
+};
+
+// Images: each icon decoded pixel by pixel, by display_draw_image() and as a
+// pre-expanded RGB565 bitmap. Consecutive iterations alternate between two
+// positions a pixel apart so every call changes pixels.
+static const struct {
+    const char *name;
+    const image_t *img;
+} image_cases[] = {
+    { "icon_rail",      &icon_rail },
+    { "icon_camera",    &icon_camera },
+    { "icon_settings",  &icon_settings },
+    { "icon_stack",     &icon_stack },
+};
+
+static const image_t *bench_img;
+static uint16_t expanded[64 * 64];
+
+static int image_x(uint16_t c) { return c == WHITE ? 41 : 40; }
+
+static void pp_image(uint16_t c) {
+    const image_t *img = bench_img;
+    int p = 0;
+    for (int i = 0; i < img->runs; i++) {
+        int index = img->data[i] & 0x0F;
+        for (int n = (img->data[i] >> 4) + 1; n > 0; n--, p++) {
+            if (index == img->transparent) continue;
+            display_draw_pixel(image_x(c) + p % img->w, 50 + p / img->w, img->palette[index]);
+        }
+    }
+}
+static void bl_image(uint16_t c) { display_draw_image(image_x(c), 50, bench_img); }
+static void bm_image(uint16_t c) {
+    display_draw_bitmap16(image_x(c), 50, expanded, bench_img->w, bench_img->h);
+}
+
+// Transparent pixels become black in the bitmap
+static void expand_image(const image_t *img) {
+    int p = 0;
+    for (int i = 0; i < img->runs; i++) {
+        int index = img->data[i] & 0x0F;
+        for (int n = (img->data[i] >> 4) + 1; n > 0; n--) {
+            expanded[p++] = index == img->transparent ? BLACK : img->palette[index];
+        }
+    }
+}
+
+static uint16_t reference[TFT_WIDTH * TFT_HEIGHT];
+
+static double now_ns(void) {
+    struct timespec ts;
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+// Average ns per call, best of ROUNDS to filter out host noise. Colours
+// alternate so every call changes pixels; the flush in between is not timed.
+static double time_draw(draw_fn_t fn) {
+    double best = 0;
+    for (int round = 0; round < ROUNDS; round++) {
+        double total = 0;
+        for (int i = 0; i < ITERATIONS; i++) {
+            uint16_t color = (i & 1) ? WHITE : BLUE;
+            double t0 = now_ns();
+            fn(color);
+            total += now_ns() - t0;
+            display_flush_dirty();
+        }
+        if (round == 0 || total < best) best = total;
+    }
+    return best / ITERATIONS;
+}
+
+static void draw_once(draw_fn_t fn) {
+    display_fill_screen(BLACK);
+    display_flush_dirty();
+    fn(YELLOW);
+    display_flush_dirty();
+}
+
+static bool same_pixels(draw_fn_t a, draw_fn_t b, const char *name) {
+    draw_once(a);
+    memcpy(reference, host_bus_panel(), sizeof(reference));
+    draw_once(b);
+    if (memcmp(reference, host_bus_panel(), sizeof(reference)) != 0) {
+        fprintf(stderr, "%s: fast path draws different pixels\n", name);
+        return false;
+    }
+    return true;
+}
+
+int main(void) {
+    for (int i = 0; i < 32 * 32; i++) {
+        sprite16[i] = (uint16_t)(i * 2654435761u >> 16);
+    }
+    for (int i = 0; i < 32 * 4; i++) {
+        sprite1[i] = (uint8_t)(i * 37 + 0x5A);
+    }
+
+    display_init();
+    display_flush_dirty();
+
+    printf("%-16s %8s %12s %12s %9s\n", "case", "pixels", "pixel ns", "block ns", "speedup");
+    for (size_t i = 0; i < sizeof(cases) / sizeof(cases[0]); i++) {
+        const bench_case_t *c = &cases[i];
+
+        if (!same_pixels(c->per_pixel, c->block, c->name)) return 1;
+
+        double pp = time_draw(c->per_pixel);
+        double bl = time_draw(c->block);
+        printf("%-16s %8d %12.0f %12.0f %8.1fx\n", c->name, c->pixels, pp, bl, pp / bl);
+    }
+
+    printf("\n%-16s %8s %12s %12s %9s\n", "text", "chars", "pixel ch/s", "glyph ch/s", "speedup");
+    for (size_t i = 0; i < sizeof(text_cases) / sizeof(text_cases[0]); i++) {
+        text_size = text_cases[i].size;
+        text_opaque = text_cases[i].opaque;
+
+        if (!same_pixels(pp_text, bl_text, text_cases[i].name)) return 1;
+
+        double pp = time_draw(pp_text);
+        double bl = time_draw(bl_text);
+        int chars = text_chars();
+        printf("%-16s %8d %12.0f %12.0f %8.1fx\n", text_cases[i].name, chars,
+               chars * 1e9 / pp, chars * 1e9 / bl, pp / bl);
+    }
+
+    printf("\n%-16s %8s %7s %7s %12s %12s %12s\n", "image", "pixels", "bytes", "raw",
+           "pixel Mpx/s", "rle Mpx/s", "bmp16 Mpx/s");
+    for (size_t i = 0; i < sizeof(image_cases) / sizeof(image_cases[0]); i++) {
+        const image_t *img = image_cases[i].img;
+        int pixels = img->w * img->h;
+        bench_img = img;
+        expand_image(img);
+
+        if (!same_pixels(pp_image, bl_image, image_cases[i].name)) return 1;
+
+        double pp = time_draw(pp_image);
+        double bl = time_draw(bl_image);
+        double bm = time_draw(bm_image);
+        printf("%-16s %8d %7d %7d %12.1f %12.1f %12.1f\n", image_cases[i].name, pixels,
+               img->runs + 2 * img->colors, 2 * pixels,
+               pixels * 1e3 / pp, pixels * 1e3 / bl, pixels * 1e3 / bm);
+    }
+    return 0;
+}
@@ -0,0 +1,67 @@
+#!/bin/sh
+# Runs primitives_bench against the specialised and the generic
+# (-DDISPLAY_GENERIC_RASTER=1) raster core on the same workload and prints
+# the fast-path columns side by side. Run from the repository root; extra
+# arguments go to the compiler, e.g. -DDISPLAY_FB_BPP=4. RUNS sets how many
+# times each build runs (default 3).
+set -e
+
+SRC="tools/display_host/primitives_bench.c tools/display_host/host_bus.c src/display.c
+     src/dirty_region.c src/dirty_tiles.c src/font.c src/font_data.c src/image_data.c"
+OUT=${TMPDIR:-/tmp}
+
+# Both builds run the same fill loop, but where it lands decides its speed
+# on x86: a loop branch across a 32-byte boundary is slowed by the JCC
+# erratum microcode, and whichever build happens to get that layout loses
+# by up to 2x on the block fills. Pad branches when the assembler can, so
+# the comparison shows the specialisation and not the code layout.
+PAD=
+if echo 'int main(void) { return 0; }' |
+        cc -Wa,-mbranches-within-32B-boundaries -x c -o /dev/null - 2>/dev/null; then
+    PAD=-Wa,-mbranches-within-32B-boundaries
+fi
+
+cc -O2 -Iinclude -Itools/display_host $PAD "$@" -o "$OUT/bench_specialised" $SRC
+cc -O2 -Iinclude -Itools/display_host -DDISPLAY_GENERIC_RASTER=1 $PAD "$@" -o "$OUT/bench_generic" $SRC
+# Runs alternate between the builds so load on the host hits both alike,
+# and each row keeps its best result
+RUNS=${RUNS:-3}
+FILES_S=
+FILES_G=
+i=1
+while [ "$i" -le "$RUNS" ]; do
+    "$OUT/bench_specialised" > "$OUT/bench_specialised.$i.txt"
+    "$OUT/bench_generic" > "$OUT/bench_generic.$i.txt"
+    FILES_S="$FILES_S $OUT/bench_specialised.$i.txt"
+    FILES_G="$FILES_G $OUT/bench_generic.$i.txt"
+    i=$((i + 1))
+done
+
+echo "branch padding: ${PAD:-not available, block fills may differ by code layout}"
+echo "best of $RUNS alternating runs"
+echo
+
+# Block rows are ns per call (lower is better), text rows chars/s and image
+# rows the run-length decoder in Mpx/s (both higher is better)
+paste -d '|' $FILES_S $FILES_G | awk -F '|' -v runs="$RUNS" '
+    $1 ~ /^case/ { printf "%-16s %14s %14s %8s\n", "case (ns)", "specialised", "generic", "gain"; fmt = "%-16s %14.0f %14.0f %7.2fx\n"; next }
+    $1 ~ /^text/ { printf "\n%-16s %14s %14s %8s\n", "text (ch/s)", "specialised", "generic", "gain"; rate = 1; next }
+    $1 ~ /^image/ { printf "\n%-16s %14s %14s %8s\n", "rle (Mpx/s)", "specialised", "generic", "gain"; fmt = "%-16s %14.1f %14.1f %7.2fx\n"; next }
+    NF < 2 || $1 == "" { next }
+    {
+        # The block, glyph or rle column: second to last
+        name = substr($1, 1, 16)
+        for (i = 1; i <= 2 * runs; i++) {
+            n = split($i, f, " ")
+            v = f[n - 1] + 0
+            k = 1
+            if (i > runs) k = 2
+            if (i == 1 || i == runs + 1) best[k] = v
+            else if (rate && v > best[k]) best[k] = v
+            else if (!rate && v < best[k]) best[k] = v
+        }
+        spec = best[1]; gen = best[2]
+        if (rate) gain = spec / gen
+        else gain = gen / spec
+        printf fmt, name, spec, gen, gain
+    }'
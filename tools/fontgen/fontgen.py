@@ -0,0 +1,143 @@
+#!/usr/bin/env python3
+"""Generates the font atlases in src/font_data.c from include/font5x7.h.
+
+    python3 tools/fontgen/fontgen.py > src/font_data.c
+
+Run it again after changing font5x7.h. Each font is emitted row-major, one
+uint16_t per glyph row with bit 15 as the leftmost pixel, so the renderer can
+write a glyph row as a single span. Glyphs are trimmed to their ink for
+proportional spacing, except digits, which keep the full cell so numbers stay
+aligned while they change.
+
+font_small is the 5x7 font itself. font_large is the same font scaled 2x with
+Scale2x edge smoothing, which rounds off the diagonals that plain pixel
+doubling leaves as stair steps.
+"""
+
+import os
+import re
+import sys
+
+FIRST = 32
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+FONT5X7_H = os.path.join(HERE, "..", "..", "include", "font5x7.h")
+
+
+def load_font5x7():
+    """Returns a list of 7x5 bitmaps (lists of rows of 0/1)."""
+    glyphs = []
+    with open(FONT5X7_H) as f:
+        for line in f:
+            m = re.match(r"\s*G\(([^)]*)\)", line)
+            if not m:
+                continue
+            cols = [int(v, 16) for v in m.group(1).split(",")]
+            glyphs.append([[(cols[x] >> y) & 1 for x in range(5)] for y in range(7)])
+    if len(glyphs) != 95:
+        sys.exit("font5x7.h: expected 95 glyphs, found %d" % len(glyphs))
+    return glyphs
+
+
+def scale2x(bitmap):
+    """Scale2x / EPX: doubles the bitmap, filling corners along diagonals."""
+    h, w = len(bitmap), len(bitmap[0])
+
+    def px(x, y):
+        if 0 <= x < w and 0 <= y < h:
+            return bitmap[y][x]
+        return 0
+
+    out = [[0] * (2 * w) for _ in range(2 * h)]
+    for y in range(h):
+        for x in range(w):
+            p = px(x, y)
+            a, b, c, d = px(x, y - 1), px(x + 1, y), px(x - 1, y), px(x, y + 1)
+            e0 = a if (c == a and c != d and a != b) else p
+            e1 = b if (a == b and a != c and b != d) else p
+            e2 = c if (d == c and d != b and c != a) else p
+            e3 = d if (b == d and b != a and d != c) else p
+            out[2 * y][2 * x] = e0
+            out[2 * y][2 * x + 1] = e1
+            out[2 * y + 1][2 * x] = e2
+            out[2 * y + 1][2 * x + 1] = e3
+    return out
+
+
+def trim(bitmap, char, space_width):
+    """Returns (width, bitmap) with blank columns removed on both sides."""
+    w = len(bitmap[0])
+    if char == " ":
+        return space_width, [[0] * space_width for _ in bitmap]
+    if char.isdigit():
+        return w, bitmap
+    ink = [x for x in range(w) if any(row[x] for row in bitmap)]
+    if not ink:
+        return space_width, [[0] * space_width for _ in bitmap]
+    x0, x1 = ink[0], ink[-1]
+    return x1 - x0 + 1, [row[x0:x1 + 1] for row in bitmap]
+
+
+def row_word(row):
+    v = 0
+    for i, bit in enumerate(row):
+        if bit:
+            v |= 0x8000 >> i
+    return v
+
+
+def char_comment(char):
+    return "'\\\\'" if char == "\\" else "'%s'" % char
+
+
+def emit_font(name, glyphs, height, spacing, line_height, space_width):
+    widths = []
+    rows = []
+    for i, bitmap in enumerate(glyphs):
+        char = chr(FIRST + i)
+        w, bm = trim(bitmap, char, space_width)
+        widths.append(w)
+        rows.append(([row_word(r) for r in bm], char))
+
+    out = []
+    out.append("static const uint8_t %s_widths[%d] = {" % (name, len(glyphs)))
+    for i in range(0, len(widths), 16):
+        out.append("    " + ", ".join("%d" % w for w in widths[i:i + 16]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("static const uint16_t %s_rows[%d * %d] = {" % (name, len(glyphs), height))
+    for words, char in rows:
+        out.append("    " + ", ".join("0x%04X" % v for v in words) + ", // " + char_comment(char))
+    out.append("};")
+    out.append("")
+    out.append("const font_t %s = {" % name)
+    out.append("    .height = %d," % height)
+    out.append("    .line_height = %d," % line_height)
+    out.append("    .spacing = %d," % spacing)
+    out.append("    .first = %d," % FIRST)
+    out.append("    .count = %d," % len(glyphs))
+    out.append("    .widths = %s_widths," % name)
+    out.append("    .rows = %s_rows," % name)
+    out.append("};")
+    out.append("")
+    return out
+
+
+def main():
+    base = load_font5x7()
+
+    out = [
+        "// Generated by tools/fontgen/fontgen.py from include/font5x7.h. Do not edit.",
+        "",
+        "#include <stdint.h>",
+        "",
+        '#include "font.h"',
+        "",
+    ]
+    out += emit_font("font_small", base, 7, 1, 8, 3)
+    out += emit_font("font_large", [scale2x(g) for g in base], 14, 2, 16, 5)
+    sys.stdout.write("\n".join(out).rstrip("\n") + "\n")
+
+
+if __name__ == "__main__":
+    main()
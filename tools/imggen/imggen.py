@@ -0,0 +1,181 @@
+#!/usr/bin/env python3
+"""Generates the palette run-length images in src/image_data.c.
+
+    python3 tools/imggen/imggen.py > src/image_data.c
+
+Run it again after changing or adding an image in tools/imggen/icons. Each
+image becomes an image_t named after its file (icons/rail.txt -> icon_rail).
+
+Sources are either text or PPM (P3 or P6). A text image starts with its
+palette, one "<char> <rrggbb>" or "<char> transparent" line per colour, then
+a blank line and one line of characters per pixel row; '#' lines are
+comments. A PPM has no transparency.
+
+Colours are converted to RGB565 in panel byte order. Pixels are stored
+row-major as runs of one byte: high nibble run length - 1, low nibble palette
+index, so at most 16 colours and 16 pixels per run. Runs continue across
+row ends; the decoder in display.c splits them again. The size against a raw
+RGB565 bitmap is reported on stderr.
+"""
+
+import os
+import sys
+
+HERE = os.path.dirname(os.path.abspath(__file__))
+ICONS = os.path.join(HERE, "icons")
+
+MAX_COLORS = 16
+MAX_RUN = 16
+
+
+def rgb565_panel(r, g, b):
+    v = ((r & 0xF8) << 8) | ((g & 0xFC) << 3) | (b >> 3)
+    return ((v & 0xFF) << 8) | (v >> 8)
+
+
+def load_text(path):
+    """Returns (pixels, palette, transparent) from a text image."""
+    keys, palette, transparent = {}, [], -1
+    rows = []
+    in_pixels = False
+    with open(path) as f:
+        for line in f:
+            line = line.rstrip("\n")
+            if line.startswith("#"):
+                continue
+            if not in_pixels:
+                if not line.strip():
+                    in_pixels = bool(keys)
+                    continue
+                char, value = line.split(None, 1)
+                if value == "transparent":
+                    transparent = len(palette)
+                    palette.append(0)
+                else:
+                    v = int(value, 16)
+                    palette.append(rgb565_panel(v >> 16, (v >> 8) & 0xFF, v & 0xFF))
+                keys[char] = len(palette) - 1
+            elif line:
+                try:
+                    rows.append([keys[c] for c in line])
+                except KeyError as e:
+                    sys.exit("%s: colour %s not in the palette" % (path, e))
+    if not rows or any(len(r) != len(rows[0]) for r in rows):
+        sys.exit("%s: rows must all be the same length" % path)
+    return rows, palette, transparent
+
+
+def ppm_tokens(data):
+    """Yields the header fields of a PPM, then the offset of the pixel data."""
+    i = 0
+    fields = 0
+    while fields < 4:
+        while data[i:i + 1].isspace():
+            i += 1
+        if data[i:i + 1] == b"#":
+            while data[i:i + 1] not in (b"\n", b""):
+                i += 1
+            continue
+        start = i
+        while not data[i:i + 1].isspace():
+            i += 1
+        yield data[start:i]
+        fields += 1
+    yield i + 1
+
+
+def load_ppm(path):
+    """Returns (pixels, palette, -1) from a P3 or P6 image."""
+    with open(path, "rb") as f:
+        data = f.read()
+    tokens = ppm_tokens(data)
+    magic, w, h, maxval = next(tokens), int(next(tokens)), int(next(tokens)), int(next(tokens))
+    if magic == b"P6":
+        raw = data[next(tokens):]
+    elif magic == b"P3":
+        raw = [int(v) for v in data[next(tokens):].split()]
+    else:
+        sys.exit("%s: not a P3 or P6 PPM" % path)
+
+    colors = {}
+    rows = []
+    for y in range(h):
+        row = []
+        for x in range(w):
+            i = 3 * (y * w + x)
+            r, g, b = (raw[i + k] * 255 // maxval for k in range(3))
+            c = rgb565_panel(r, g, b)
+            row.append(colors.setdefault(c, len(colors)))
+        rows.append(row)
+    return rows, list(colors), -1
+
+
+def encode(rows):
+    """Returns the run bytes for rows of palette indices."""
+    pixels = [p for row in rows for p in row]
+    out = []
+    i = 0
+    while i < len(pixels):
+        n = 1
+        while n < MAX_RUN and i + n < len(pixels) and pixels[i + n] == pixels[i]:
+            n += 1
+        out.append((n - 1) << 4 | pixels[i])
+        i += n
+    return out
+
+
+def emit_image(name, path):
+    if path.endswith(".txt"):
+        rows, palette, transparent = load_text(path)
+    else:
+        rows, palette, transparent = load_ppm(path)
+    if len(palette) > MAX_COLORS:
+        sys.exit("%s: %d colours, at most %d" % (path, len(palette), MAX_COLORS))
+
+    w, h = len(rows[0]), len(rows)
+    runs = encode(rows)
+    sys.stderr.write("%-16s %3dx%-3d %2d colours %5d bytes (raw %d, %.1fx)\n" % (
+        name, w, h, len(palette), len(runs) + 2 * len(palette), 2 * w * h,
+        2.0 * w * h / (len(runs) + 2 * len(palette))))
+
+    out = []
+    out.append("static const uint16_t %s_palette[%d] = {" % (name, len(palette)))
+    out.append("    " + ", ".join("0x%04X" % c for c in palette) + ",")
+    out.append("};")
+    out.append("")
+    out.append("static const uint8_t %s_data[%d] = {" % (name, len(runs)))
+    for i in range(0, len(runs), 12):
+        out.append("    " + ", ".join("0x%02X" % b for b in runs[i:i + 12]) + ",")
+    out.append("};")
+    out.append("")
+    out.append("const image_t %s = {" % name)
+    out.append("    .w = %d," % w)
+    out.append("    .h = %d," % h)
+    out.append("    .colors = %d," % len(palette))
+    out.append("    .transparent = %d," % transparent)
+    out.append("    .runs = %d," % len(runs))
+    out.append("    .palette = %s_palette," % name)
+    out.append("    .data = %s_data," % name)
+    out.append("};")
+    out.append("")
+    return out
+
+
+def main():
+    out = [
+        "// Generated by tools/imggen/imggen.py from tools/imggen/icons. Do not edit.",
+        "",
+        "#include <stdint.h>",
+        "",
+        '#include "image.h"',
+        "",
+    ]
+    for file in sorted(os.listdir(ICONS)):
+        base, ext = os.path.splitext(file)
+        if ext in (".txt", ".ppm"):
+            out += emit_image("icon_" + base, os.path.join(ICONS, file))
+    sys.stdout.write("\n".join(out).rstrip("\n") + "\n")
+
+
+if __name__ == "__main__":
+    main()
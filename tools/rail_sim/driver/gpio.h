@@ -0,0 +1,35 @@
+#ifndef GPIO_H
+#define GPIO_H
+
+#include <stdint.h>
+
+// Host stand-in for the ESP-IDF GPIO driver, as far as stepper.c uses it.
+// Levels written to the STEP and DIR pins go to the rail model (rail_host.c).
+
+typedef int gpio_num_t;
+
+#define GPIO_NUM_25             25
+#define GPIO_NUM_26             26
+#define GPIO_NUM_27             27
+
+typedef enum {
+    GPIO_INTR_DISABLE = 0,
+} gpio_int_type_t;
+
+typedef enum {
+    GPIO_MODE_OUTPUT = 2,
+} gpio_mode_t;
+
+typedef struct {
+    uint64_t pin_bit_mask;
+    gpio_mode_t mode;
+    int pull_up_en;
+    int pull_down_en;
+    gpio_int_type_t intr_type;
+} gpio_config_t;
+
+// Function prototypes
+int gpio_config(const gpio_config_t *cfg);
+int gpio_set_level(gpio_num_t gpio_num, uint32_t level);
+
+#endif // GPIO_H
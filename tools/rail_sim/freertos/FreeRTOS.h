@@ -0,0 +1,18 @@
+#ifndef FREERTOS_H
+#define FREERTOS_H
+
+#include <stdint.h>
+
+// Host stand-in for the FreeRTOS types and tick conversion stepper.c uses.
+// The tick rate is a bench parameter, so pdMS_TO_TICKS() truncates exactly
+// as it does on the target for whatever CONFIG_FREERTOS_HZ is being tried.
+
+typedef uint32_t TickType_t;
+typedef int BaseType_t;
+
+uint32_t rail_host_tick_hz(void);
+
+#define configTICK_RATE_HZ      rail_host_tick_hz()
+#define pdMS_TO_TICKS(ms)       ((TickType_t)(((uint64_t)(ms) * configTICK_RATE_HZ) / 1000))
+
+#endif // FREERTOS_H
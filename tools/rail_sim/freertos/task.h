@@ -0,0 +1,9 @@
+#ifndef TASK_H
+#define TASK_H
+
+#include "freertos/FreeRTOS.h"
+
+// Function prototypes
+void vTaskDelay(TickType_t ticks);
+
+#endif // TASK_H
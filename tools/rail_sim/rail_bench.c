@@ -0,0 +1,266 @@
+// Host benchmark for motion parameters, run against the rail model.
+//
+//   cc -O2 -Wall -Iinclude -Itools/rail_sim -Itools/display_host -o rail_bench
+//      tools/rail_sim/rail_bench.c tools/rail_sim/rail_sim.c
+//      tools/rail_sim/rail_host.c src/stepper.c -lm
+//   ./rail_bench tick_hz=1000
+//   ./rail_bench profile=ramp max_sps=8000 accel=40000
+//
+// By default every move runs through the firmware's own stepper_move(),
+// built for the host by rail_host.c: one STEP pulse per microstep with a
+// vTaskDelay(pdMS_TO_TICKS(2)) on each side, so the step rate follows from
+// tick_hz and the gpio and yield costs. profile=ramp replaces it with a
+// trapezoidal speed profile, a candidate for a ramped stepper_move() that
+// the firmware does not have yet.
+//
+// The report gives move time, final error and residual vibration for each
+// standard move. Move time runs until the carriage stays within a twentieth
+// of a microstep of its rest position; error and residual are measured from
+// the last STEP edge. With a gentle stop the carriage just follows the last
+// microstep and friction holds it; a ramp with start_sps near the resonance
+// shows the ringing.
+
+#include <math.h>
+#include <stdbool.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#include "rail_sim.h"
+#include "rail_host.h"
+#include "stepper.h"
+
+typedef enum {
+    PROFILE_FIRMWARE,           // stepper_move() as built for the target
+    PROFILE_RAMP,               // Trapezoidal profile below
+} profile_t;
+
+// Motion parameters under test
+typedef struct {
+    profile_t profile;
+    rail_host_timing_t timing;  // Firmware profile
+    double start_sps;           // Speed the profile starts and ends at
+    double max_sps;             // Cruise speed
+    double accel;               // steps/s^2
+    int pulse_us;               // STEP high time
+    int dir_setup_us;           // DIR to first STEP edge
+} motion_params_t;
+
+// Standard moves, in microsteps
+typedef struct {
+    const char *name;
+    int steps;
+    int return_steps;           // Non-zero: reverse by this much afterwards
+} bench_move_t;
+
+static const bench_move_t standard_moves[] = {
+    { "1 ustep",        1,      0 },
+    { "1 full step",    16,     0 },
+    { "0.05 mm",        160,    0 },
+    { "0.5 mm",         1600,   0 },
+    { "5 mm",           16000,  0 },
+    { "reversal",       800,    800 },
+};
+
+// Settled once the carriage stays within a fraction of a microstep of where
+// it comes to rest, taken as the mean of the last part of the window. Moves
+// still moving in that tail are reported as not settled.
+#define SETTLE_WINDOW_US    200000
+#define SETTLE_TAIL_US      10000
+#define SETTLE_TOL_USTEP    0.05
+
+typedef struct {
+    double move_time_ms;        // First edge until settled
+    bool settled;               // Came to rest inside the settle window
+    double final_error_um;      // Rest position against the commanded one
+    int missed_usteps;
+    double lag_um;              // Command minus position at the last edge
+    double residual_pp_um;      // Peak-to-peak about the final command once caught up
+} bench_result_t;
+
+// Emits one ramp profile move and returns the time of its last rising STEP edge. The
+// move's final step period ends at *end, where a following move may start.
+static int64_t emit_move(rail_sim_t *sim, int64_t t, int steps, const motion_params_t *mp,
+                         int64_t *end) {
+    int64_t last_edge = t;
+    int n = abs(steps);
+    double v0sq = mp->start_sps * mp->start_sps;
+
+    rail_sim_gpio(sim, t, RAIL_SIM_PIN_DIR, steps > 0 ? 1 : 0);
+    t += mp->dir_setup_us;
+
+    for (int i = 0; i < n; i++) {
+        double v_up = sqrt(v0sq + 2.0 * mp->accel * i);
+        double v_down = sqrt(v0sq + 2.0 * mp->accel * (n - 1 - i));
+        double v = fmin(mp->max_sps, fmin(v_up, v_down));
+        int64_t period = (int64_t)(1e6 / v);
+        if (period < 2 * mp->pulse_us) period = 2 * mp->pulse_us;
+
+        rail_sim_gpio(sim, t, RAIL_SIM_PIN_STEP, 1);
+        rail_sim_gpio(sim, t + mp->pulse_us, RAIL_SIM_PIN_STEP, 0);
+        last_edge = t;
+        t += period;
+    }
+    *end = t;
+    return last_edge;
+}
+
+// Peak-to-peak of the offsets once the carriage has caught up with the last
+// step: from where it first crosses the command position or stops closing
+// in on it. The approach itself is the last microstep's travel, not
+// vibration.
+static double residual_pp(const double *x, int count) {
+    int i = 0;
+    while (i + 1 < count && (x[i + 1] > 0) == (x[0] > 0) && fabs(x[i + 1]) < fabs(x[i])) {
+        i++;
+    }
+    double lo = x[i], hi = x[i];
+    for (; i < count; i++) {
+        if (x[i] < lo) lo = x[i];
+        if (x[i] > hi) hi = x[i];
+    }
+    return hi - lo;
+}
+
+static bench_result_t run_move(const rail_sim_config_t *cfg, const motion_params_t *mp,
+                               const bench_move_t *move) {
+    rail_sim_t sim;
+    bench_result_t r = {0};
+
+    rail_sim_init(&sim, cfg);
+
+    // The firmware's pin trace is replayed as the model advances, up to the
+    // last STEP edge here and the rest during the settle window
+    const rail_host_edge_t *trace = NULL;
+    size_t trace_count = 0, next = 0;
+    int64_t last_edge;
+    if (mp->profile == PROFILE_FIRMWARE) {
+        rail_host_reset(&mp->timing);
+        stepper_init();
+        stepper_enable(true);
+        stepper_move(move->steps);
+        if (move->return_steps) {
+            stepper_move(-move->return_steps);
+        }
+        last_edge = rail_host_last_step_edge_us();
+        trace = rail_host_trace(&trace_count);
+        for (; next < trace_count && trace[next].t_us <= last_edge; next++) {
+            rail_sim_gpio(&sim, trace[next].t_us, trace[next].pin, trace[next].level);
+        }
+    } else {
+        int64_t end;
+        last_edge = emit_move(&sim, 0, move->steps, mp, &end);
+        if (move->return_steps) {
+            last_edge = emit_move(&sim, end, -move->return_steps, mp, &end);
+        }
+    }
+
+    // Sample the settle window at 50 us, from the last STEP edge on, as the
+    // offset from the final command position
+    int64_t settled_at = last_edge;
+    double command = rail_sim_command_um(&sim);
+    double samples[SETTLE_WINDOW_US / 50];
+    int count = 0;
+    for (int64_t ts = last_edge; ts < last_edge + SETTLE_WINDOW_US; ts += 50) {
+        for (; next < trace_count && trace[next].t_us <= ts; next++) {
+            rail_sim_gpio(&sim, trace[next].t_us, trace[next].pin, trace[next].level);
+        }
+        rail_sim_advance(&sim, ts);
+        double x = rail_sim_position_um(&sim) - command;
+        samples[count++] = x;
+    }
+    int tail = SETTLE_TAIL_US / 50;
+    double rest = 0.0;
+    for (int i = count - tail; i < count; i++) {
+        rest += samples[i];
+    }
+    rest /= tail;
+
+    double tol = SETTLE_TOL_USTEP * rail_sim_um_per_ustep(&sim);
+    int last_out = -1;
+    for (int i = 0; i < count; i++) {
+        if (fabs(samples[i] - rest) > tol) last_out = i;
+    }
+    settled_at = last_edge + (int64_t)(last_out + 1) * 50;
+
+    r.move_time_ms = settled_at / 1000.0;
+    r.settled = last_out < count - tail;
+    r.final_error_um = rest;
+    r.missed_usteps = rail_sim_missed_usteps(&sim);
+    r.lag_um = -samples[0];
+    r.residual_pp_um = residual_pp(samples, count);
+    return r;
+}
+
+static void parse_arg(const char *arg, rail_sim_config_t *cfg, motion_params_t *mp) {
+    const char *eq = strchr(arg, '=');
+    if (!eq) {
+        fprintf(stderr, "ignoring '%s' (expected key=value)\n", arg);
+        return;
+    }
+    size_t len = eq - arg;
+    double v = atof(eq + 1);
+
+    if (!strncmp(arg, "profile", len)) {
+        if (!strcmp(eq + 1, "firmware")) mp->profile = PROFILE_FIRMWARE;
+        else if (!strcmp(eq + 1, "ramp")) mp->profile = PROFILE_RAMP;
+        else fprintf(stderr, "unknown profile '%s' (firmware or ramp)\n", eq + 1);
+    } else if (!strncmp(arg, "tick_hz", len)) mp->timing.tick_hz = (uint32_t)v;
+    else if (!strncmp(arg, "gpio_us", len)) mp->timing.gpio_us = (int)v;
+    else if (!strncmp(arg, "yield_us", len)) mp->timing.yield_us = (int)v;
+    else if (!strncmp(arg, "start_sps", len)) mp->start_sps = v;
+    else if (!strncmp(arg, "max_sps", len)) mp->max_sps = v;
+    else if (!strncmp(arg, "accel", len)) mp->accel = v;
+    else if (!strncmp(arg, "pulse_us", len)) mp->pulse_us = (int)v;
+    else if (!strncmp(arg, "pitch", len)) cfg->pitch_mm = v;
+    else if (!strncmp(arg, "microsteps", len)) cfg->microsteps = (int)v;
+    else if (!strncmp(arg, "mass", len)) cfg->carriage_mass_kg = v;
+    else if (!strncmp(arg, "inertia", len)) cfg->rotor_inertia = v;
+    else if (!strncmp(arg, "damping", len)) cfg->damping = v;
+    else if (!strncmp(arg, "friction", len)) cfg->friction_nm = v;
+    else fprintf(stderr, "unknown parameter '%.*s'\n", (int)len, arg);
+}
+
+int main(int argc, char **argv) {
+    rail_sim_config_t cfg;
+    motion_params_t mp = {
+        .start_sps = 400,
+        .max_sps = 6000,
+        .accel = 30000,
+        .pulse_us = 5,
+        .dir_setup_us = 5,
+    };
+
+    rail_sim_default_config(&cfg);
+    rail_host_default_timing(&mp.timing);
+    for (int i = 1; i < argc; i++) {
+        parse_arg(argv[i], &cfg, &mp);
+    }
+
+    rail_sim_t probe;
+    rail_sim_init(&probe, &cfg);
+    double k = cfg.curve[0].torque_nm * cfg.full_steps_per_rev / 4.0;
+    printf("rail: %.3f um/ustep, resonance ~%.0f Hz\n",
+           rail_sim_um_per_ustep(&probe), sqrt(k / probe.inertia) / (2.0 * M_PI));
+    if (mp.profile == PROFILE_FIRMWARE) {
+        printf("profile: firmware stepper_move(), tick %u Hz, gpio %d us, yield %d us\n\n",
+               (unsigned)mp.timing.tick_hz, mp.timing.gpio_us, mp.timing.yield_us);
+    } else {
+        printf("profile: ramp, start %.0f, max %.0f steps/s, accel %.0f steps/s^2\n\n",
+               mp.start_sps, mp.max_sps, mp.accel);
+    }
+
+    printf("%-12s %8s %10s %12s %8s %8s %12s\n",
+           "move", "usteps", "time ms", "error um", "missed", "lag um", "residual um");
+    for (size_t i = 0; i < sizeof(standard_moves) / sizeof(standard_moves[0]); i++) {
+        const bench_move_t *m = &standard_moves[i];
+        bench_result_t r = run_move(&cfg, &mp, m);
+        char time[16];
+        if (r.settled) snprintf(time, sizeof(time), "%.2f", r.move_time_ms);
+        else snprintf(time, sizeof(time), "unsettled");
+        printf("%-12s %8d %10s %12.3f %8d %8.3f %12.3f\n",
+               m->name, m->steps - m->return_steps, time, r.final_error_um,
+               r.missed_usteps, r.lag_um, r.residual_pp_um);
+    }
+    return 0;
+}
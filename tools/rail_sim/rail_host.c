@@ -0,0 +1,94 @@
+#include <stdio.h>
+#include <stdlib.h>
+
+#include "rail_host.h"
+#include "stepper.h"
+#include "step_diag.h"
+#include "driver/gpio.h"
+#include "freertos/FreeRTOS.h"
+#include "freertos/task.h"
+
+static rail_host_timing_t host_timing;
+static int64_t now_us;
+static int64_t last_step_edge_us;
+
+static rail_host_edge_t *trace;
+static size_t trace_count;
+static size_t trace_capacity;
+
+void rail_host_default_timing(rail_host_timing_t *timing) {
+    timing->tick_hz = 100;      // sdkconfig.az-delivery-devkit-v4
+    timing->gpio_us = 1;
+    timing->yield_us = 5;
+}
+
+// Restarts the clock at 0 and clears the trace
+void rail_host_reset(const rail_host_timing_t *timing) {
+    host_timing = *timing;
+    now_us = 0;
+    last_step_edge_us = 0;
+    trace_count = 0;
+}
+
+const rail_host_edge_t *rail_host_trace(size_t *count) {
+    *count = trace_count;
+    return trace;
+}
+
+int64_t rail_host_last_step_edge_us(void) {
+    return last_step_edge_us;
+}
+
+uint32_t rail_host_tick_hz(void) {
+    return host_timing.tick_hz;
+}
+
+static void record(int pin, int level) {
+    if (trace_count == trace_capacity) {
+        trace_capacity = trace_capacity ? trace_capacity * 2 : 4096;
+        trace = realloc(trace, trace_capacity * sizeof(*trace));
+        if (!trace) {
+            fprintf(stderr, "out of memory for the pin trace\n");
+            exit(1);
+        }
+    }
+    trace[trace_count++] = (rail_host_edge_t){ now_us, pin, level };
+}
+
+int gpio_config(const gpio_config_t *cfg) {
+    (void)cfg;
+    return 0;
+}
+
+int gpio_set_level(gpio_num_t gpio_num, uint32_t level) {
+    now_us += host_timing.gpio_us;
+    if (gpio_num == STEP_PIN) {
+        if (level) last_step_edge_us = now_us;
+        record(RAIL_SIM_PIN_STEP, level);
+    } else if (gpio_num == DIR_PIN) {
+        record(RAIL_SIM_PIN_DIR, level);
+    }
+    return 0;
+}
+
+// Wakes on the tick boundary the given number of ticks on, as the scheduler
+// does, so a delay of n ticks lasts between n - 1 and n tick periods
+void vTaskDelay(TickType_t ticks) {
+    if (ticks == 0) {
+        now_us += host_timing.yield_us;
+        return;
+    }
+    int64_t tick_us = 1000000 / host_timing.tick_hz;
+    now_us = (now_us / tick_us + ticks) * tick_us;
+}
+
+// Step timing diagnostics have nothing to record on the host
+void step_diag_move_begin(int steps) {
+    (void)steps;
+}
+
+void step_diag_edge(void) {
+}
+
+void step_diag_move_end(void) {
+}
@@ -0,0 +1,33 @@
+#ifndef RAIL_HOST_H
+#define RAIL_HOST_H
+
+#include <stddef.h>
+#include <stdint.h>
+#include "rail_sim.h"
+
+// Runs the firmware's stepper.c on the host. Its gpio_set_level() and
+// vTaskDelay() calls advance a simulated clock, and the STEP/DIR levels are
+// recorded with the time they would reach the pins, ready to be replayed
+// into the rail model.
+
+// Target timing of the calls stepper_move() makes
+typedef struct {
+    uint32_t tick_hz;           // CONFIG_FREERTOS_HZ
+    int gpio_us;                // One gpio_set_level()
+    int yield_us;               // vTaskDelay(0), which only yields
+} rail_host_timing_t;
+
+// One recorded pin transition
+typedef struct {
+    int64_t t_us;
+    int pin;                    // RAIL_SIM_PIN_STEP or RAIL_SIM_PIN_DIR
+    int level;
+} rail_host_edge_t;
+
+// Function prototypes
+void rail_host_default_timing(rail_host_timing_t *timing);
+void rail_host_reset(const rail_host_timing_t *timing);
+const rail_host_edge_t *rail_host_trace(size_t *count);
+int64_t rail_host_last_step_edge_us(void);
+
+#endif // RAIL_HOST_H
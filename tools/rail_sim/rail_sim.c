@@ -0,0 +1,133 @@
+#include <math.h>
+#include <string.h>
+
+#include "rail_sim.h"
+
+// Rotor teeth of a hybrid stepper: one electrical cycle is four full steps
+#define FULL_STEPS_PER_ELEC_CYCLE 4
+
+void rail_sim_default_config(rail_sim_config_t *cfg) {
+    memset(cfg, 0, sizeof(*cfg));
+    cfg->pitch_mm = 1.0;
+    cfg->full_steps_per_rev = 200;
+    cfg->microsteps = 16;
+    cfg->rotor_inertia = 54e-7;         // NEMA17, 54 g cm^2
+    cfg->carriage_mass_kg = 0.6;
+    cfg->damping = 1.0e-3;
+    cfg->friction_nm = 0.02;
+
+    // Typical 0.4 N m NEMA17 on a 12 V driver
+    cfg->curve_points = 5;
+    cfg->curve[0] = (rail_sim_torque_point_t){ 0.0, 0.40 };
+    cfg->curve[1] = (rail_sim_torque_point_t){ 2.0, 0.36 };
+    cfg->curve[2] = (rail_sim_torque_point_t){ 5.0, 0.25 };
+    cfg->curve[3] = (rail_sim_torque_point_t){ 10.0, 0.10 };
+    cfg->curve[4] = (rail_sim_torque_point_t){ 15.0, 0.0 };
+
+    cfg->dt_s = 2e-6;
+}
+
+void rail_sim_init(rail_sim_t *sim, const rail_sim_config_t *cfg) {
+    memset(sim, 0, sizeof(*sim));
+    sim->cfg = *cfg;
+
+    sim->mm_per_rad = cfg->pitch_mm / (2.0 * M_PI);
+    double m_per_rad = sim->mm_per_rad / 1000.0;
+    sim->inertia = cfg->rotor_inertia + cfg->carriage_mass_kg * m_per_rad * m_per_rad;
+    sim->rad_per_ustep = 2.0 * M_PI / (cfg->full_steps_per_rev * cfg->microsteps);
+}
+
+// Pull-out torque available at the given shaft speed, linear between points
+static double available_torque(const rail_sim_config_t *cfg, double omega) {
+    double rps = fabs(omega) / (2.0 * M_PI);
+    const rail_sim_torque_point_t *c = cfg->curve;
+
+    if (cfg->curve_points == 0) return 0.0;
+    if (rps <= c[0].speed_rps) return c[0].torque_nm;
+    for (int i = 1; i < cfg->curve_points; i++) {
+        if (rps <= c[i].speed_rps) {
+            double f = (rps - c[i - 1].speed_rps) / (c[i].speed_rps - c[i - 1].speed_rps);
+            return c[i - 1].torque_nm + f * (c[i].torque_nm - c[i - 1].torque_nm);
+        }
+    }
+    return c[cfg->curve_points - 1].torque_nm;
+}
+
+// Electrical angle per mechanical radian
+static double elec_ratio(const rail_sim_config_t *cfg) {
+    return (double)cfg->full_steps_per_rev / FULL_STEPS_PER_ELEC_CYCLE;
+}
+
+static void integrate(rail_sim_t *sim, double dt) {
+    const rail_sim_config_t *cfg = &sim->cfg;
+    double target = sim->command_usteps * sim->rad_per_ustep;
+    double n = elec_ratio(cfg);
+
+    // Sinusoidal torque-angle curve. Once the load angle passes a quarter
+    // electrical cycle the rotor drops into the next detent, which is how a
+    // real motor loses steps.
+    double torque = available_torque(cfg, sim->omega) * sin(n * (target - sim->theta));
+    torque -= cfg->damping * sim->omega;
+
+    // Coulomb friction, holding the carriage when the drive cannot overcome
+    // it. Only a rotor that has all but stopped sticks: ringing passes
+    // through zero speed with the full spring torque behind it and carries
+    // on. Friction opposes the motion, or from rest the torque breaking it
+    // loose.
+    if (fabs(sim->omega) < 1e-3 && fabs(torque) <= cfg->friction_nm) {
+        sim->omega = 0.0;
+        return;
+    }
+    double moving = sim->omega != 0.0 ? sim->omega : torque;
+    torque -= (moving >= 0 ? 1.0 : -1.0) * cfg->friction_nm;
+
+    sim->omega += torque / sim->inertia * dt;
+    sim->theta += sim->omega * dt;
+}
+
+void rail_sim_advance(rail_sim_t *sim, int64_t t_us) {
+    if (t_us <= sim->t_us) return;
+
+    double remaining = (t_us - sim->t_us) * 1e-6 + sim->t_frac_s;
+    while (remaining >= sim->cfg.dt_s) {
+        integrate(sim, sim->cfg.dt_s);
+        remaining -= sim->cfg.dt_s;
+    }
+    sim->t_frac_s = remaining;
+    sim->t_us = t_us;
+}
+
+// Applies a pin transition. The driver latches DIR and advances one
+// microstep on each rising STEP edge.
+void rail_sim_gpio(rail_sim_t *sim, int64_t t_us, int pin, int level) {
+    rail_sim_advance(sim, t_us);
+
+    if (pin == RAIL_SIM_PIN_DIR) {
+        sim->dir_level = level;
+    } else if (pin == RAIL_SIM_PIN_STEP) {
+        if (level && !sim->step_level) {
+            sim->command_usteps += sim->dir_level ? 1 : -1;
+        }
+        sim->step_level = level;
+    }
+}
+
+double rail_sim_position_um(const rail_sim_t *sim) {
+    return sim->theta * sim->mm_per_rad * 1000.0;
+}
+
+double rail_sim_command_um(const rail_sim_t *sim) {
+    return sim->command_usteps * sim->rad_per_ustep * sim->mm_per_rad * 1000.0;
+}
+
+double rail_sim_um_per_ustep(const rail_sim_t *sim) {
+    return sim->rad_per_ustep * sim->mm_per_rad * 1000.0;
+}
+
+// Microsteps lost to slipping, in whole electrical cycles
+int rail_sim_missed_usteps(const rail_sim_t *sim) {
+    double target = sim->command_usteps * sim->rad_per_ustep;
+    double cycle = 2.0 * M_PI / elec_ratio(&sim->cfg);
+    long cycles = lround((target - sim->theta) / cycle);
+    return (int)(cycles * FULL_STEPS_PER_ELEC_CYCLE * sim->cfg.microsteps);
+}
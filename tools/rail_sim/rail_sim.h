@@ -0,0 +1,63 @@
+#ifndef RAIL_SIM_H
+#define RAIL_SIM_H
+
+#include <stdint.h>
+#include <stdbool.h>
+
+// Host-side model of the stepper and focus rail. It is driven by the same
+// STEP/DIR pin transitions that stepper.c writes to the GPIOs, stamped with
+// the time (us) they would happen on the target.
+
+#define RAIL_SIM_PIN_STEP       0
+#define RAIL_SIM_PIN_DIR        1
+
+#define RAIL_SIM_MAX_CURVE_POINTS 8
+
+// One point on the pull-out torque curve
+typedef struct {
+    double speed_rps;           // Shaft speed, rev/s
+    double torque_nm;           // Available torque at that speed
+} rail_sim_torque_point_t;
+
+// Mechanical and driver parameters
+typedef struct {
+    double pitch_mm;            // Lead-screw travel per revolution
+    int full_steps_per_rev;     // 200 for a 1.8 degree motor
+    int microsteps;             // Driver microstepping
+    double rotor_inertia;       // kg m^2
+    double carriage_mass_kg;    // Moving mass, reflected through the screw
+    double damping;             // Viscous damping, N m s/rad
+    double friction_nm;         // Coulomb friction of screw and slide
+    int curve_points;           // Torque-speed curve, sorted by speed
+    rail_sim_torque_point_t curve[RAIL_SIM_MAX_CURVE_POINTS];
+    double dt_s;                // Integration step
+} rail_sim_config_t;
+
+typedef struct {
+    rail_sim_config_t cfg;
+    double inertia;             // Total inertia at the shaft
+    double rad_per_ustep;       // Commanded angle per microstep
+    double mm_per_rad;
+
+    int64_t t_us;               // Simulation time
+    double t_frac_s;            // Integrator time not yet consumed
+    int step_level;
+    int dir_level;
+    int64_t command_usteps;     // Microsteps commanded so far
+
+    double theta;               // Rotor angle, rad
+    double omega;               // Rotor speed, rad/s
+} rail_sim_t;
+
+// Function prototypes
+void rail_sim_default_config(rail_sim_config_t *cfg);
+void rail_sim_init(rail_sim_t *sim, const rail_sim_config_t *cfg);
+void rail_sim_advance(rail_sim_t *sim, int64_t t_us);
+void rail_sim_gpio(rail_sim_t *sim, int64_t t_us, int pin, int level);
+
+double rail_sim_position_um(const rail_sim_t *sim);
+double rail_sim_command_um(const rail_sim_t *sim);
+double rail_sim_um_per_ustep(const rail_sim_t *sim);
+int rail_sim_missed_usteps(const rail_sim_t *sim);
+
+#endif // RAIL_SIM_H